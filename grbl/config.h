@@ -319,6 +319,34 @@
 // coordinates through Grbl '$#' print parameters.
 #define MESSAGE_PROBE_COORDINATES // Enabled by default. Comment to disable.
 
+// Keeps the last probe results in a RAM ring buffer, with their position, success flag and line
+// number, so a host can run a series of probes and read them all at once with '$P'. '$PC' clears
+// the buffer. Each result takes 5 bytes plus 4 bytes per axis of RAM.
+#define ENABLE_PROBE_RESULT_BUFFER // Enabled by default. Comment to disable.
+#define N_PROBE_RESULT 16 // Number of results kept (1-127)
+
+// Compensates the Z axis of all the motions with a surface height map, so descents can run at full
+// speed to a shallow depth on a plate or deck that is not level. Probe the grid row by row, from the
+// first grid point, each row in the same X direction, then load it from the probe result buffer with
+// '$MP'. '$MC' clears the map and '$M' prints it. Offsets are relative to the first grid point and
+// interpolated between the grid points. Motions are split in HEIGHT_MAP_SEGMENT_LENGTH segments.
+// Jogs are not split, and are only compensated at their target.
+// NOTE: Requires ENABLE_PROBE_RESULT_BUFFER. The map is kept in RAM and cleared upon power-up.
+// Soft limits and reported machine positions include the offset. G53 motions are not compensated, and
+// soft limits apply to their machine target as programmed.
+#define ENABLE_HEIGHT_MAP // Enabled by default. Comment to disable.
+#define HEIGHT_MAP_COLUMNS 3 // Grid points along X (2-N_PROBE_RESULT)
+#define HEIGHT_MAP_ROWS 3 // Grid points along Y
+#define HEIGHT_MAP_SEGMENT_LENGTH 5.0 // Maximum XY length of the compensated segments (mm)
+
+// Enables the G68 XY coordinate transform, to calibrate deck plate holders rotated or skewed on the
+// gantry. G68 X Y R I J K sets the center, the rotation in degrees, the X and Y scales and the skew
+// of X along Y in degrees. Missing X and Y default to the current position. G69 cancels it. The
+// transform applies to all motions but G53, is kept in EEPROM across resets and is printed by '$#'.
+// NOTE: Soft limits are checked on the transformed machine positions. Reported machine positions are
+// transformed.
+#define ENABLE_COORD_TRANSFORM // Enabled by default. Comment to disable.
+
 // After the safety door switch has been toggled and restored, this setting sets the power-up delay
 // between restoring the spindle and coolant and resuming the cycle.
 #define SAFETY_DOOR_SPINDLE_DELAY 4.0 // Float (seconds)
@@ -454,6 +482,35 @@
 #define REPORT_WCO_REFRESH_BUSY_COUNT 30  // (2-255)
 #define REPORT_WCO_REFRESH_IDLE_COUNT 10  // (2-255) Must be less than or equal to the busy count
 
+// Enables push-mode status reports. Grbl sends a status report on its own every '$RI=<ms>' milliseconds,
+// timed by a millisecond tick on Timer5, so a GUI doesn't have to spend a '?' poll and a host round-trip
+// per report. '$RI=0' stops push reports and '$RI' prints the interval. The interval survives a soft-reset,
+// but not a power cycle. '?' polls still work as usual while push reports are running.
+// NOTE: AUTO_REPORT_INTERVAL sets the interval at power-up. Zero disables push reports until '$RI' is sent.
+#define ENABLE_AUTO_REPORT // Default enabled. Comment to disable.
+#define AUTO_REPORT_INTERVAL 0 // Milliseconds (0-65535). Default 0. Push reports off at power-up.
+#define AUTO_REPORT_MIN_INTERVAL 10 // Milliseconds. Shortest interval accepted by '$RI='.
+
+// Push reports are only sent when the machine state, position or executing line number has changed
+// since the last push report. A keep-alive report is still sent every AUTO_REPORT_KEEPALIVE milliseconds,
+// so a GUI can tell Grbl is still connected. Only applies to push reports, not to '?' polls.
+#define AUTO_REPORT_CHANGES_ONLY // Default enabled. Comment to disable.
+#define AUTO_REPORT_KEEPALIVE 1000 // Milliseconds (1-65535)
+
+// Push reports leave out the buffer state 'Bf:' and pin state 'Pn:' fields, which a GUI may still poll
+// with '?' when needed. The WCO and override fields follow their usual refresh counts.
+// #define AUTO_REPORT_REDUCED_FIELDS // Default disabled. Uncomment to enable.
+
+// Adds a compact binary status report frame, selected by setting bit 2 of the '$10' status report mask
+// (i.e. '$10=5' for binary frames with machine position). The frame carries machine position in steps,
+// machine state, buffer states, realtime feed rate and line number with a CRC, in 40 bytes with 6 axes,
+// instead of well over 100 bytes of text. It also skips all decimal conversions on Grbl's side, which
+// makes high rate push reports much cheaper. See report_binary_status() in report.c for the layout.
+// NOTE: Requires a GUI able to parse the frames. Work coordinate offsets are not included, so a GUI
+// needs to get them from '$#' and the g-code state. Requires ENABLE_TX_PRIORITY_BUFFER, which keeps
+// the frames out of the text lines.
+// #define ENABLE_BINARY_STATUS_REPORT // Default disabled. Uncomment to enable.
+
 // The temporal resolution of the acceleration management subsystem. A higher number gives smoother
 // acceleration, particularly noticeable on machines that run at very high feedrates, but may negatively
 // impact performance. The correct value for this parameter is machine dependent, so it's advised to
@@ -557,6 +614,12 @@
 // much greater than this. The default setting should capture most, if not all, full arc error situations.
 #define ARC_ANGULAR_TRAVEL_EPSILON 5E-7 // Float (radians)
 
+// Plans the junctions between the line segments of an arc from the arc radius itself, as the path of
+// centripetal acceleration, instead of the junction deviation ($11) corner approximation. The arc
+// speed then follows the axis accelerations and the arc curvature, and no longer depends on the ratio
+// of the junction deviation to the arc tolerance ($12). Junctions into and out of the arc are unchanged.
+#define ARC_CURVATURE_JUNCTION_SPEED // Default enabled. Comment to disable.
+
 // Time delay increments performed during a dwell. The default value is set at 50ms, which provides
 // a maximum time delay of roughly 55 minutes, more than enough for most any application. Increasing
 // this delay will increase the maximum dwell time linearly, but also reduces the responsiveness of
@@ -610,16 +673,106 @@
 // #define RX_BUFFER_SIZE 255 // Uncomment to override defaults in serial.h
 // #define TX_BUFFER_SIZE 255
 
+// Realtime status reports are written to a small separate send buffer, which the serial interrupt
+// sends ahead of bulk output, like '$$' or '$#', at the next line boundary. While Grbl waits on a
+// full send buffer, status report requests are also answered through it, so a GUI keeps getting
+// position updates during long messages. Costs TX_PRIORITY_BUFFER_SIZE bytes of RAM.
+// NOTE: Regardless of this option, Grbl keeps the step segment buffer fed while waiting on a full
+// send buffer, so long messages no longer starve the stepper during a cycle.
+#define ENABLE_TX_PRIORITY_BUFFER // Default enabled. Comment to disable.
+// #define TX_PRIORITY_BUFFER_SIZE 127 // Uncomment to override default in serial.h. Must be less than 256.
+
 // The maximum line length of a data string stored in EEPROM. Used by startup lines and build
 // info. This size differs from the LINE_BUFFER_SIZE as the EEPROM is usually limited in size.
 // NOTE: Be very careful when changing this value. Check EEPROM address locations to make sure
 // these string storage locations won't corrupt one another.
 // #define EEPROM_LINE_SIZE 80 // Uncomment to override defaults in settings.h
 
+// Enables the '%' program delimiter. A line with a single '%' starts a program and the next one ends
+// it. While a program is running, auto-cycle start follows the buffered start policy below, instead of
+// starting motion on the first empty serial read buffer. The ending '%' starts any motion left in the
+// buffer. A '%' with anything else on its line, or without this option, is passed to the g-code
+// parser, which rejects it.
+#define ENABLE_PROGRAM_MODE // Default enabled. Comment to disable.
+
+// Applies the buffered start policy to all streamed motions, not only inside '%' programs. Auto-cycle
+// start then waits until the planner buffer holds AUTO_CYCLE_START_DISTANCE mm or AUTO_CYCLE_START_TIME
+// milliseconds of nominal motion, the planner buffer is full, or the buffered motions have waited for
+// AUTO_CYCLE_START_TIMEOUT milliseconds, whichever comes first. This avoids starting with a single short
+// block and stopping again when a bursty link leaves the host briefly slower than Grbl.
+// NOTE: Buffer syncs, like G4 dwells or probing, still start the cycle right away. Single commands sent
+// by hand will start after the timeout. Comment out the distance or time threshold to not use it.
+// #define ENABLE_AUTO_CYCLE_START_POLICY // Default disabled. Uncomment to enable.
+#define AUTO_CYCLE_START_DISTANCE 10.0 // Float (mm)
+#define AUTO_CYCLE_START_TIME 200.0 // Float (milliseconds)
+#define AUTO_CYCLE_START_TIMEOUT 500 // Milliseconds (1-65535)
+
+// Executes the common streamed blocks of only axis words, with optional F, N, and G0/G1 words, through a
+// short parser path, while Grbl is in G0 or G1 and G94 mode. It skips the full parser block setup and the
+// modal group error-checks, since these blocks can't change any other modal state. Any other block is
+// passed to the full g-code parser as before, which also reports any error.
+// NOTE: Not available with USE_OUTPUT_PWM, which requires a Q word in every block.
+#define ENABLE_PARSER_FAST_PATH // Default enabled. Comment to disable.
+
+// Enables o-word subroutines stored in EEPROM. An 'O100 SUB' line starts a definition. The following
+// g-code lines are stored, not executed, up to the 'O100 ENDSUB' line. Then an 'O100 CALL [1.5] [2]'
+// line runs the stored lines, which read the bracketed call arguments as #1, #2, and so on. Unset
+// arguments are zero. 'O100 RETURN' ends the call early. '$' system commands are never stored.
+// Subroutines are kept through resets and power cycles, and are erased by '$RST=*'.
+// Within a subroutine, 'O<n> WHILE [expr]' ... 'O<n> ENDWHILE', 'O<n> REPEAT [expr]' ... 'O<n> ENDREPEAT'
+// with 'O<n> BREAK' and 'O<n> CONTINUE', and 'O<n> IF [expr]' ... 'O<n> ELSEIF [expr]' ... 'O<n> ELSE' ...
+// 'O<n> ENDIF' run from the stored lines, without any host round-trip. Expressions take the + - * / MOD **
+// EQ NE GT GE LT LE AND OR XOR operators, functions like ABS[] or SQRT[], and #5070, which is 1 if the
+// last probing cycle found the probe. Nested blocks must have different o-word numbers.
+// Lines like '#31=[#1*2]' set call arguments and the global parameters from #31, and any g-code word can
+// take a parameter or expression value, as in 'G0 Z[#5063-2]'. System values are read-only, like the
+// last probe position #5061-#5066, G54-G59 offsets from #5221, or the current position #5420-#5425.
+// #5220 is the current coordinate system, 1 for G54 to 6 for G59, and 9+P for G54.1 P.
+// NOTE: Storing a line takes a few milliseconds per character, so a definition waits for any buffered
+// motion to finish first. Space is limited, see EEPROM_ADDR_SUBROUTINES in settings.h.
+#define ENABLE_O_WORD_SUBROUTINES // Default enabled. Comment to disable.
+#define OWORD_MAX_CALL_DEPTH 3 // Nested subroutine calls (1-255)
+#define OWORD_MAX_PARAMETERS 8 // Call arguments per subroutine (1-30)
+#define OWORD_MAX_REPEAT_DEPTH 4 // Nested repeat loops, over all running subroutines (1-255)
+#define OWORD_GLOBAL_PARAMETERS 20 // Global parameters, from #31 (1-255)
+
+// Enables the G70 well plate canned cycle. 'G70 X10 Y12 Z-3 R2 I9 J9 P12 L8 F300' visits the 96 wells
+// of a 12 by 8 plate, starting at the X10 Y12 well and 9mm apart in X (I) and Y (J). At each well, it
+// moves over the well at the R retract height, feeds down to the Z depth and retracts. P columns and
+// L rows default to one. Rows are visited in serpentine order, and the cycle ends above the last well.
+// The motions are queued as the planner buffer frees up, so the cycle is acknowledged right away.
+// NOTE: A following motion, dwell or buffer sync waits until the last motion of the cycle is queued.
+// Modal-only blocks, like F or G90, execute right away.
+#define ENABLE_WELL_PLATE_CYCLE // Default enabled. Comment to disable.
+
+// Enables the G54.1 P1-P48 extended work coordinate systems, for instance one per labware position on
+// the deck. 'G54.1 P5' selects the fifth one, and 'G10 L2 P0' or 'G10 L20 P0' sets the active one, as
+// with G54-G59. The active one is reported by '$#'. Offsets are stored to the micron, up to +/-8388mm.
+// The most recently used systems are kept in RAM, so switching between them rarely reads EEPROM.
+// NOTE: They are stored ahead of the o-word subroutines, which lose a slot for every 27 systems.
+// Enabling them restores all the EEPROM data upon the first boot. After changing their number, send
+// '$RST=*' to clear the moved subroutines.
+#define ENABLE_EXTENDED_COORDINATE_SYSTEMS // Default enabled. Comment to disable.
+#define N_EXTENDED_COORDINATE_SYSTEM 48 // G54.1 P1 up to P48 (1-99)
+#define EXTENDED_COORD_CACHE_SIZE 4 // Systems kept in RAM (1-255)
+
 // Configures the position after a probing cycle during Grbl's check mode. Disabled sets
 // the position to the probe target, when enabled sets the position to the start position.
 // #define SET_CHECK_MODE_PROBE_TO_START // Default disabled. Uncomment to enable.
 
+// Captures the probe contact with the probe pin change interrupt, timestamped against the stepper
+// timer, instead of at the next stepper interrupt tick. The reported probe position is interpolated
+// between steps from the step rate of the executing segment, so fast probing keeps its accuracy.
+// NOTE: Requires the probe pin to have a pin change interrupt, see PROBE_INT in cpu_map.h. Not
+// compatible with a filtered probe pin, see INPUT_FILTER_PROBE.
+#define ENABLE_PROBE_CAPTURE // Default enabled. Comment to disable.
+
+// Enables two-stage probing on G38.2-G38.5 with the R and P words, e.g. G38.2 Z-20 F300 P30 R1.
+// The probe seeks at the F feed rate, retracts the R distance back toward the start position, then
+// touches again at the P feed rate. Only the final contact is reported and sets the position. R and
+// P are in the current units and must be given together. Not available in inverse time mode.
+#define ENABLE_TWO_STAGE_PROBE // Default enabled. Comment to disable.
+
 // Force Grbl to check the state of the hard limit switches when the processor detects a pin
 // change inside the hard limit ISR routine. By default, Grbl will trigger the hard limits
 // alarm upon any pin change, since bouncing switches can cause a state check like this to
@@ -630,6 +783,25 @@
 // NOTE: This option has no effect if SOFTWARE_DEBOUNCE is enabled.
 // #define HARD_LIMIT_FORCE_STATE_CHECK // Default disabled. Uncomment to enable.
 
+// Enables digital filtering of the input pins, for chattering switches or sensors. The pins are
+// sampled every millisecond by the tick, and read as triggered or not only once their filter agrees.
+// INPUT_FILTER_MAJORITY follows most of the last samples, up to 8. INPUT_FILTER_INTEGRATOR counts
+// samples up while triggered and down while not, and switches upon reaching the sample count or zero.
+// A group set to INPUT_FILTER_NONE is read directly from its pins, as when disabled.
+// NOTE: A filter delays the inputs by about half its samples in milliseconds, or all of them for
+// the integrator. The probe position is recorded when the filtered probe triggers. The control pins
+// act once their filtered state is triggered, instead of from the pin change interrupt. Hard limits
+// for RAMPS trip from the filtered limits. The homing cycle reads the limit pins directly.
+// #define ENABLE_INPUT_FILTER // Default disabled. Uncomment to enable.
+#define INPUT_FILTER_LIMITS INPUT_FILTER_INTEGRATOR
+#define INPUT_FILTER_LIMITS_SAMPLES 3 // (1-255, or 1-8 for majority)
+#define INPUT_FILTER_PROBE INPUT_FILTER_MAJORITY
+#define INPUT_FILTER_PROBE_SAMPLES 5 // (1-255, or 1-8 for majority)
+#define INPUT_FILTER_CONTROL INPUT_FILTER_INTEGRATOR
+#define INPUT_FILTER_CONTROL_SAMPLES 3 // (1-255, or 1-8 for majority)
+#define INPUT_FILTER_DIGITAL INPUT_FILTER_INTEGRATOR
+#define INPUT_FILTER_DIGITAL_SAMPLES 3 // (1-255, or 1-8 for majority)
+
 // Adjusts homing cycle search and locate scalars. These are the multipliers used by Grbl's
 // homing cycle to ensure the limit switches are engaged and cleared through each phase of
 // the cycle. The search phase uses the axes max-travel setting times the SEARCH_SCALAR to
@@ -678,6 +850,15 @@
 // job. At this time, this option only forces a planner buffer sync with these g-code commands.
 #define FORCE_BUFFER_SYNC_DURING_EEPROM_WRITE // Default enabled. Comment to disable.
 
+// Queues EEPROM writes and programs them in the background from the EEPROM ready interrupt. Writes
+// then never disable interrupts, and return right away while the queue has room. Reads return any
+// pending value. Since active stepping and serial data are no longer at risk, coordinate set g-code
+// commands (G10,G28.1,G30.1) don't force a planner buffer sync with this option either.
+// NOTE: A byte takes ~3.4ms to program. A coordinate set write takes 25 bytes. Queued bytes are lost
+// upon a power loss, as they would be with a write in progress.
+#define ENABLE_EEPROM_WRITE_QUEUE // Default enabled. Comment to disable.
+#define EEPROM_WRITE_QUEUE_SIZE 64 // Queued bytes (2-255)
+
 // In Grbl v0.9 and prior, there is an old outstanding bug where the `WPos:` work position reported
 // may not correlate to what is executing, because `WPos:` is based on the g-code parser state, which
 // can be several motions behind. This option forces the planner buffer to empty, sync, and stop
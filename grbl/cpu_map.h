@@ -200,10 +200,11 @@
   // Enable Hardware limit support for RAMPS without using interrupt...
   // Warning! bouncing switches can cause a state check like this to misread the pin.
   // When hard limits are triggered, they should be 100% reliable.
-  // The RAMPS_HW_LIMIT is implemented inside the stepper driver interrupt. Depending of your
-  // hardware, this can affect the max speed possibility of movments
-  // Disabled by default for performance optimization, uncomment to enable.
+  // The RAMPS_HW_LIMIT pins are polled every millisecond by the tick interrupt, and must read
+  // triggered for RAMPS_HW_LIMITS_DEBOUNCE polls in a row, which filters out short glitches.
+  // Disabled by default, uncomment to enable.
   //#define ENABLE_RAMPS_HW_LIMITS
+  //#define RAMPS_HW_LIMITS_DEBOUNCE 2 // Consecutive millisecond polls (1-255)
 
   // Define spindle enable and spindle direction output pins.
   #define SPINDLE_ENABLE_DDR      DDRG
@@ -256,6 +257,9 @@
   #define PROBE_PORT      PORTK
   #define PROBE_BIT       7  // MEGA2560 Analog Pin 15
   #define PROBE_MASK      (1<<PROBE_BIT)
+  #define PROBE_INT       PCIE2  // Pin change interrupt enable pin. Shared with the control pins.
+  #define PROBE_INT_vect  PCINT2_vect
+  #define PROBE_PCMSK     PCMSK2 // Pin change interrupt register
 
   #ifdef USE_ANALOG_INPUT
     // Define Analog input
@@ -84,7 +84,20 @@ uint8_t digital_get_state()
     digital_state |= DIGITAL_OUTPUT_STATE_P3;
   }
   // Input status
-  #ifdef USE_DIGITAL_INPUT
+  #ifdef INPUT_FILTERED_DIGITAL
+    digital_state |= input_filter_digital;
+  #elif defined(USE_DIGITAL_INPUT)
+    digital_state |= digital_get_input_pin_state();
+  #endif
+  return(digital_state);
+}
+
+
+#ifdef USE_DIGITAL_INPUT
+  // Returns the digital input pin state as DIGITAL_INPUT_STATE bits, read directly from the pins.
+  uint8_t digital_get_input_pin_state()
+  {
+    uint8_t digital_state = 0;
     #ifdef INVERT_DIGITAL_INPUT_PIN_0
       if (DIGITAL_INPUT_PIN_0 & DIGITAL_INPUT_MASK_0) {
     #else
@@ -113,9 +126,9 @@ uint8_t digital_get_state()
     #endif
       digital_state |= DIGITAL_INPUT_STATE_P3;
     }
-  #endif
-  return(digital_state);
-}
+    return(digital_state);
+  }
+#endif
 
 
 // Directly called by digital_init(), digital_set_state(), and mc_reset(), which can be at
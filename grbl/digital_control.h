@@ -39,6 +39,11 @@ void digital_init();
 // Returns current digital output state. Overrides may alter it from programmed state.
 uint8_t digital_get_state();
 
+#ifdef USE_DIGITAL_INPUT
+  // Returns the digital input pin state, without input filtering.
+  uint8_t digital_get_input_pin_state();
+#endif
+
 // Immediately disables digital output pins.
 void digital_stop(const uint8_t n);
 
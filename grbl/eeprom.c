@@ -21,8 +21,7 @@
 *                         $Revision: 1.6 $
 *                         $Date: Friday, February 11, 2005 07:16:44 UTC $
 ****************************************************************************/
-#include <avr/io.h>
-#include <avr/interrupt.h>
+#include "grbl.h"
 
 /* These EEPROM bits have different names on different devices. */
 #ifndef EEPE
@@ -37,6 +36,13 @@
 /* Define to reduce code size. */
 #define EEPROM_IGNORE_SELFPROG //!< Remove SPM flag polling.
 
+// Keeps the EEPROM ready interrupt enabled, when writes are queued, upon any EECR write below.
+#ifdef ENABLE_EEPROM_WRITE_QUEUE
+  #define EECR_QUEUE_BITS (1<<EERIE)
+#else
+  #define EECR_QUEUE_BITS 0
+#endif
+
 /*! \brief  Read byte from EEPROM.
  *
  *  This function reads one byte from a given EEPROM address.
@@ -46,6 +52,7 @@
  *  \param  addr  EEPROM address to read from.
  *  \return  The byte read from the EEPROM address.
  */
+#ifndef ENABLE_EEPROM_WRITE_QUEUE
 unsigned char eeprom_get_char( unsigned int addr )
 {
 	do {} while( EECR & (1<<EEPE) ); // Wait for completion of previous write.
@@ -53,6 +60,7 @@ unsigned char eeprom_get_char( unsigned int addr )
 	EECR = (1<<EERE); // Start EEPROM read operation.
 	return EEDR; // Return the byte read from EEPROM.
 }
+#endif
 
 /*! \brief  Write byte to EEPROM.
  *
@@ -71,20 +79,14 @@ unsigned char eeprom_get_char( unsigned int addr )
  *  \param  addr  EEPROM address to write to.
  *  \param  new_value  New EEPROM value.
  */
-void eeprom_put_char( unsigned int addr, unsigned char new_value )
+// Programs one byte with the most efficient mode. The EEPROM must be ready and interrupts disabled.
+static void eeprom_program_char( unsigned int addr, unsigned char new_value )
 {
 	char old_value; // Old EEPROM value.
 	char diff_mask; // Difference mask, i.e. old value XOR new value.
 
-	cli(); // Ensure atomic operation for the write operation.
-	
-	do {} while( EECR & (1<<EEPE) ); // Wait for completion of previous write.
-	#ifndef EEPROM_IGNORE_SELFPROG
-	do {} while( SPMCSR & (1<<SELFPRGEN) ); // Wait for completion of SPM.
-	#endif
-	
 	EEAR = addr; // Set EEPROM address register.
-	EECR = (1<<EERE); // Start EEPROM read operation.
+	EECR = (1<<EERE) | EECR_QUEUE_BITS; // Start EEPROM read operation.
 	old_value = EEDR; // Get old EEPROM value.
 	diff_mask = old_value ^ new_value; // Get bit differences.
 	
@@ -97,13 +99,13 @@ void eeprom_put_char( unsigned int addr, unsigned char new_value )
 			// Now we know that some bits need to be programmed to '0' also.
 			
 			EEDR = new_value; // Set EEPROM data register.
-			EECR = (1<<EEMPE) | // Set Master Write Enable bit...
+			EECR = EECR_QUEUE_BITS | (1<<EEMPE) | // Set Master Write Enable bit...
 			       (0<<EEPM1) | (0<<EEPM0); // ...and Erase+Write mode.
 			EECR |= (1<<EEPE);  // Start Erase+Write operation.
 		} else {
 			// Now we know that all bits should be erased.
 
-			EECR = (1<<EEMPE) | // Set Master Write Enable bit...
+			EECR = EECR_QUEUE_BITS | (1<<EEMPE) | // Set Master Write Enable bit...
 			       (1<<EEPM0);  // ...and Erase-only mode.
 			EECR |= (1<<EEPE);  // Start Erase-only operation.
 		}
@@ -115,17 +117,106 @@ void eeprom_put_char( unsigned int addr, unsigned char new_value )
 			// Now we know that _some_ bits need to the programmed to '0'.
 			
 			EEDR = new_value;   // Set EEPROM data register.
-			EECR = (1<<EEMPE) | // Set Master Write Enable bit...
+			EECR = EECR_QUEUE_BITS | (1<<EEMPE) | // Set Master Write Enable bit...
 			       (1<<EEPM1);  // ...and Write-only mode.
 			EECR |= (1<<EEPE);  // Start Write-only operation.
 		}
 	}
+}
+
+#ifndef ENABLE_EEPROM_WRITE_QUEUE
+void eeprom_put_char( unsigned int addr, unsigned char new_value )
+{
+	cli(); // Ensure atomic operation for the write operation.
+	
+	do {} while( EECR & (1<<EEPE) ); // Wait for completion of previous write.
+	#ifndef EEPROM_IGNORE_SELFPROG
+	do {} while( SPMCSR & (1<<SELFPRGEN) ); // Wait for completion of SPM.
+	#endif
+	
+	eeprom_program_char(addr, new_value);
 	
 	sei(); // Restore interrupt flag state.
 }
+#endif
 
 // Extensions added as part of Grbl 
 
+#ifdef ENABLE_EEPROM_WRITE_QUEUE
+// Write-behind queue of EEPROM bytes. eeprom_put_char() only queues the byte, and the EEPROM ready
+// interrupt programs the queued bytes in the background, one each ~3.4ms. So writes neither block
+// the main program nor disable interrupts. eeprom_get_char() returns the latest queued value of an
+// address, so reads always see the pending writes.
+static volatile uint16_t eeprom_queue_addr[EEPROM_WRITE_QUEUE_SIZE];
+static volatile uint8_t eeprom_queue_value[EEPROM_WRITE_QUEUE_SIZE];
+static volatile uint8_t eeprom_queue_head = 0; // Next free entry. Written by the main program only.
+static volatile uint8_t eeprom_queue_tail = 0; // Next entry to program. Written by the interrupt only.
+
+// Programs the next queued byte, or disables the interrupt once the queue is empty. The EEPROM
+// must be ready and interrupts disabled.
+static void eeprom_commit_next()
+{
+  uint8_t tail = eeprom_queue_tail;
+  if (tail == eeprom_queue_head) {
+    EECR &= ~(1<<EERIE);
+    return;
+  }
+  unsigned int addr = eeprom_queue_addr[tail];
+  unsigned char value = eeprom_queue_value[tail];
+  if (++tail == EEPROM_WRITE_QUEUE_SIZE) { tail = 0; }
+  eeprom_queue_tail = tail;
+  eeprom_program_char(addr, value);
+}
+
+// Fires whenever the EEPROM is ready, while enabled. Unchanged bytes are skipped without any
+// programming, so the interrupt then fires again right away for the next one.
+ISR(EE_READY_vect)
+{
+  eeprom_commit_next();
+}
+
+void eeprom_put_char(unsigned int addr, unsigned char new_value)
+{
+  uint8_t next_head = eeprom_queue_head+1;
+  if (next_head == EEPROM_WRITE_QUEUE_SIZE) { next_head = 0; }
+  // Wait for room in the queue. If interrupts are disabled, as during startup, commit bytes here.
+  while (next_head == eeprom_queue_tail) {
+    if (bit_isfalse(SREG,bit(SREG_I)) && bit_isfalse(EECR,bit(EEPE))) { eeprom_commit_next(); }
+  }
+  eeprom_queue_addr[eeprom_queue_head] = addr;
+  eeprom_queue_value[eeprom_queue_head] = new_value;
+  eeprom_queue_head = next_head;
+  EECR |= (1<<EERIE); // Start or keep the background writes going.
+}
+
+unsigned char eeprom_get_char(unsigned int addr)
+{
+  // Return the newest pending value of the address, if queued. Entries are never altered by the
+  // interrupt, so the queue may be scanned with interrupts enabled.
+  uint8_t idx = eeprom_queue_head;
+  uint8_t tail = eeprom_queue_tail;
+  while (idx != tail) {
+    if (idx == 0) { idx = EEPROM_WRITE_QUEUE_SIZE; }
+    idx--;
+    if (eeprom_queue_addr[idx] == addr) { return(eeprom_queue_value[idx]); }
+  }
+  // Otherwise, read it from EEPROM, once any write in progress completes. Interrupts are disabled
+  // only for the read itself, so the interrupt can't start another write on the way.
+  uint8_t sreg;
+  for (;;) {
+    sreg = SREG;
+    cli();
+    if (bit_isfalse(EECR,bit(EEPE))) { break; }
+    SREG = sreg;
+  }
+  EEAR = addr;
+  EECR |= (1<<EERE);
+  unsigned char value = EEDR;
+  SREG = sreg;
+  return(value);
+}
+#endif
+
 
 void memcpy_to_eeprom_with_checksum(unsigned int destination, char *source, unsigned int size) {
   unsigned char checksum = 0;
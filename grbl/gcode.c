@@ -57,9 +57,121 @@ void gc_init()
 void gc_sync_position()
 {
   system_convert_array_steps_to_mpos(gc_state.position,sys_position);
+  mc_convert_to_program_position(gc_state.position);
 }
 
 
+// Converts the executed G53 machine target of a block to the program position it ends at, as the
+// height map and coordinate transform don't apply to it. Other targets are left as is.
+static void gc_convert_machine_target(parser_block_t *gc_block, plan_line_data_t *pl_data)
+{
+  if (bit_istrue(pl_data->condition,PL_COND_FLAG_MACHINE_COORD)) {
+    mc_convert_to_program_position(gc_block->values.xyz);
+  }
+}
+
+#if defined(ENABLE_PARSER_FAST_PATH) && !defined(USE_OUTPUT_PWM)
+// Executes the common streamed block of axis words with an optional F and N word, and an optional
+// G0 or G1 word, while the parser is already in G0 or G1 and G94. Such a block can't change any other
+// modal state, so the STEP 3 error-checks reduce to the few below. Returns false without touching
+// the parser state, if the block needs anything else. gc_execute_line() then parses it in full and
+// reports any error, so both paths accept and reject the same blocks.
+static uint8_t gc_execute_fast_line(char *line)
+{
+  if (gc_state.modal.motion > MOTION_MODE_LINEAR) { return(false); } // G2/3, G38.x or G80 active.
+  if (gc_state.modal.feed_rate == FEED_RATE_MODE_INVERSE_TIME) { return(false); } // G93 requires F per block.
+
+  float target[N_AXIS];
+  float feed_rate = gc_state.feed_rate;
+  int32_t line_number = 0;
+  uint8_t motion = gc_state.modal.motion;
+  uint8_t axis_words = 0;
+  uint8_t value_words = 0; // Bit 0: G, bit 1: F, bit 2: N.
+  uint8_t axis_mask;
+  uint8_t char_counter = 0;
+  uint8_t idx;
+  char letter;
+  float value;
+  int32_t int_part;
+  uint8_t mantissa;
+
+  while (line[char_counter] != 0) {
+    letter = line[char_counter];
+    char_counter++;
+    if (!read_float_fixed(line, &char_counter, &value, &int_part, &mantissa)) { return(false); }
+    switch(letter) {
+      case 'G':
+        if ((value_words & bit(0)) || (mantissa != 0)) { return(false); }
+        if (int_part == 0) { motion = MOTION_MODE_SEEK; }
+        else if (int_part == 1) { motion = MOTION_MODE_LINEAR; }
+        else { return(false); }
+        value_words |= bit(0);
+        break;
+      case 'F':
+        if ((value_words & bit(1)) || (value < 0.0)) { return(false); }
+        if (gc_state.modal.units == UNITS_MODE_INCHES) { value *= MM_PER_INCH; }
+        feed_rate = value;
+        value_words |= bit(1);
+        break;
+      case 'N':
+        if ((value_words & bit(2)) || (value < 0.0) || (int_part > MAX_LINE_NUMBER)) { return(false); }
+        line_number = int_part;
+        value_words |= bit(2);
+        break;
+      default:
+        if ((letter < 'A') || (letter > 'Z')) { return(false); }
+        axis_mask = get_axis_letter_mask(letter);
+        if ((axis_mask == 0) || (axis_words & axis_mask)) { return(false); } // Not an axis or repeated.
+        for (idx=0; idx<N_AXIS; idx++) {
+          if (axis_mask & bit(idx)) { target[idx] = value; }
+        }
+        axis_words |= axis_mask;
+    }
+  }
+  if (!axis_words) { return(false); }
+  if ((motion == MOTION_MODE_LINEAR) && (feed_rate == 0.0)) { return(false); } // [Feed rate undefined]
+
+  // Convert axis words to an absolute machine target, as in STEP 3 for the motion modes.
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_isfalse(axis_words,bit(idx))) {
+      target[idx] = gc_state.position[idx];
+    } else {
+      #if N_AXIS > 3
+        if ((gc_state.modal.units == UNITS_MODE_INCHES) && (idx < N_AXIS_LINEAR)) { target[idx] *= MM_PER_INCH; }
+      #else
+        if (gc_state.modal.units == UNITS_MODE_INCHES) { target[idx] *= MM_PER_INCH; }
+      #endif
+      if (gc_state.modal.distance == DISTANCE_MODE_ABSOLUTE) {
+        target[idx] += gc_state.coord_system[idx] + gc_state.coord_offset[idx];
+        if (idx == TOOL_LENGTH_OFFSET_AXIS) { target[idx] += gc_state.tool_length_offset; }
+      } else {
+        target[idx] += gc_state.position[idx];
+      }
+    }
+  }
+
+  // Update the parser state and execute, as in STEP 4. Spindle, coolant and tool are unchanged, and
+  // an axis motion never forces a laser sync. Only the laser is off during G0 in laser mode.
+  plan_line_data_t plan_data;
+  plan_line_data_t *pl_data = &plan_data;
+  memset(pl_data,0,sizeof(plan_line_data_t));
+  gc_state.line_number = line_number;
+  pl_data->line_number = line_number;
+  gc_state.feed_rate = feed_rate;
+  pl_data->feed_rate = feed_rate;
+  if ((motion == MOTION_MODE_LINEAR) || bit_isfalse(settings.flags,BITFLAG_LASER_MODE)) {
+    pl_data->spindle_speed = gc_state.spindle_speed;
+  }
+  pl_data->condition = (gc_state.modal.spindle | gc_state.modal.coolant);
+  gc_state.modal.motion = motion;
+  if (motion == MOTION_MODE_SEEK) { pl_data->condition |= PL_COND_FLAG_RAPID_MOTION; }
+  mc_line(target, pl_data);
+  memcpy(gc_state.position, target, sizeof(target));
+  return(true);
+}
+#endif
+
+
 // Executes one line of 0-terminated G-Code. The line is assumed to contain only uppercase
 // characters and signed floating point values (no whitespace). Comments and block delete
 // characters have been removed. In this function, all units and positions are converted and
@@ -67,6 +179,16 @@ void gc_sync_position()
 // coordinates, respectively.
 uint8_t gc_execute_line(char *line)
 {
+  #ifdef ENABLE_O_WORD_SUBROUTINES
+    // O-word and parameter assignment lines, and all the lines of a subroutine definition, are
+    // handled by the o-word module.
+    if ((line[0] != '$') && ((line[0] == 'O') || (line[0] == '#') || oword_is_defining())) { return(oword_execute_line(line)); }
+  #endif
+
+  #if defined(ENABLE_PARSER_FAST_PATH) && !defined(USE_OUTPUT_PWM)
+    if (gc_execute_fast_line(line)) { return(STATUS_OK); }
+  #endif
+
   /* -------------------------------------------------------------------------------------
      STEP 1: Initialize parser block struct and copy current g-code state modes. The parser
      updates these modes and commands as the block line is parser and will only be used and
@@ -81,23 +203,10 @@ uint8_t gc_execute_line(char *line)
   gc_block.values.t = gc_state.tool;
 
   uint8_t axis_command = AXIS_COMMAND_NONE;
-  uint8_t axis_0, axis_1, axis_linear;
-  uint8_t axis_a, axis_b, axis_c;
-  uint8_t axis_u, axis_v, axis_w;
-  uint8_t axis_d, axis_e, axis_h;
-  uint8_t axis_0_mask = 0;
-  uint8_t axis_1_mask = 0;
-  uint8_t axis_linear_mask = 0;
-  uint8_t axis_a_mask = 0;
-  uint8_t axis_b_mask = 0;
-  uint8_t axis_c_mask = 0;
-  uint8_t axis_u_mask = 0;
-  uint8_t axis_v_mask = 0;
-  uint8_t axis_w_mask = 0;
-  uint8_t axis_d_mask = 0;
-  uint8_t axis_e_mask = 0;
-  uint8_t axis_h_mask = 0;
+  uint8_t axis_0, axis_1; // Representative axis indices of the active plane.
+  uint8_t axis_0_mask, axis_1_mask; // All the axes of the active plane, clones included.
   uint8_t coord_select = 0; // Tracks G10 P coordinate selection for execution
+  uint8_t idx;
 
   // Initialize bitflag tracking variables for axis indices compatible operations.
   uint32_t axis_dwords = 0; // XYZ tracking
@@ -124,11 +233,13 @@ uint8_t gc_execute_line(char *line)
      words, and for negative values set for the value words F, N, P, T, and S. */
 
   uint32_t dword_bit; // Bit-value for assigning tracking variables
+  uint8_t axis_mask;
   uint8_t char_counter;
   char letter;
   float value;
+  int32_t int_part;
   uint8_t int_value = 0;
-  uint16_t mantissa = 0;
+  uint8_t mantissa = 0;
   if (gc_parser_flags & GC_PARSER_JOG_MOTION) { char_counter = 3; } // Start parsing after `$J=`
   else { char_counter = 0; }
 
@@ -138,18 +249,19 @@ uint8_t gc_execute_line(char *line)
     letter = line[char_counter];
     if((letter < 'A') || (letter > 'Z')) { FAIL(STATUS_EXPECTED_COMMAND_LETTER); } // [Expected word letter]
     char_counter++;
-    if (!read_float(line, &char_counter, &value)) { FAIL(STATUS_BAD_NUMBER_FORMAT); } // [Expected word value]
+    #ifdef ENABLE_O_WORD_SUBROUTINES
+      if (!oword_read_word_value(line, &char_counter, &value, &int_part, &mantissa)) { FAIL(STATUS_BAD_NUMBER_FORMAT); } // [Expected word value]
+    #else
+      if (!read_float_fixed(line, &char_counter, &value, &int_part, &mantissa)) { FAIL(STATUS_BAD_NUMBER_FORMAT); } // [Expected word value]
+    #endif
 
-    // Convert values to smaller uint8 significand and mantissa values for parsing this word.
-    // NOTE: Mantissa is multiplied by 100 to catch non-integer command values. This is more
+    // Use smaller uint8 significand and mantissa values for parsing this word. Both are read as
+    // fixed-point values along with the float value, so no floating point rounding is involved.
+    // NOTE: Mantissa is in hundredths to catch non-integer command values. This is more
     // accurate than the NIST gcode requirement of x10 when used for commands, but not quite
     // accurate enough for value words that require integers to within 0.0001. This should be
-    // a good enough comprimise and catch most all non-integer errors. To make it compliant,
-    // we would simply need to change the mantissa to int16, but this add compiled flash space.
-    // Maybe update this later.
-    int_value = trunc(value);
-    mantissa =  round(100*(value - int_value)); // Compute mantissa for Gxx.x commands.
-    // NOTE: Rounding must be used to catch small floating point errors.
+    // a good enough comprimise and catch most all non-integer errors.
+    int_value = int_part;
 
     // Check if the g-code word is supported or errors due to modal group violations or has
     // been repeated in the g-code block. If ok, update the command or record its value.
@@ -161,8 +273,11 @@ uint8_t gc_execute_line(char *line)
       case 'G':
         // Determine 'G' command and its modal group
         switch(int_value) {
+          #ifdef ENABLE_WELL_PLATE_CYCLE
+            case 70:
+          #endif
           case 10: case 28: case 30: case 92:
-            // Check for G10/28/30/92 being called with G0/1/2/3/38 on same block.
+            // Check for G10/28/30/70/92 being called with G0/1/2/3/38 on same block.
             // * G43.1 is also an axis command but is not explicitly defined this way.
             if (mantissa == 0) { // Ignore G28.1, G30.1, and G92.1
               if (axis_command) { FAIL(STATUS_GCODE_AXIS_COMMAND_CONFLICT); } // [Axis word/command conflict]
@@ -178,6 +293,17 @@ uint8_t gc_execute_line(char *line)
               mantissa = 0; // Set to zero to indicate valid non-integer G command.
             }
             break;
+          #ifdef ENABLE_COORD_TRANSFORM
+            case 68: case 69:
+              // Check for G68 being called with G0/1/2/3/38 on same block. G68 axis words are its center.
+              if (int_value == 68) {
+                if (axis_command) { FAIL(STATUS_GCODE_AXIS_COMMAND_CONFLICT); } // [Axis word/command conflict]
+                axis_command = AXIS_COMMAND_NON_MODAL;
+              }
+              dword_bit = MODAL_GROUP_G0;
+              gc_block.non_modal_command = int_value+100; // NON_MODAL_SET_TRANSFORM or NON_MODAL_CANCEL_TRANSFORM
+              break;
+          #endif
           case 0: case 1: case 2: case 3: case 38:
             // Check for G0/1/2/3/38 being called with G10/28/30/92 on same block.
             // * G43.1 is also an axis command but is not explicitly defined this way.
@@ -242,6 +368,12 @@ uint8_t gc_execute_line(char *line)
             // NOTE: G59.x are not supported. (But their int_values would be 60, 61, and 62.)
             dword_bit = MODAL_GROUP_G12;
             gc_block.modal.coord_select = int_value - 54; // Shift to array indexing.
+            #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+              if ((int_value == 54) && (mantissa == 10)) { // G54.1. System set by the P word in error-checking.
+                gc_block.modal.coord_select = SETTING_INDEX_EXTENDED;
+                mantissa = 0; // Set to zero to indicate valid non-integer G command.
+              }
+            #endif
             break;
           case 61:
             dword_bit = MODAL_GROUP_G13;
@@ -327,54 +459,18 @@ uint8_t gc_execute_line(char *line)
           // case 'E': Perhaps axis name
           case 'F': dword_bit = DWORD_F; gc_block.values.f = value; break;
           // case 'H': Perhaps axis name
-          case 'I':
-            dword_bit = DWORD_I;
-            if (AXIS_1_NAME == 'X') { gc_block.values.ijk[AXIS_1] = value; ijk_words |= (1<<AXIS_1); }
-            if (AXIS_2_NAME == 'X') { gc_block.values.ijk[AXIS_2] = value; ijk_words |= (1<<AXIS_2); }
-            if (AXIS_3_NAME == 'X') { gc_block.values.ijk[AXIS_3] = value; ijk_words |= (1<<AXIS_3); }
-            #ifdef AXIS_4
-              if (AXIS_4_NAME == 'X') { gc_block.values.ijk[AXIS_4] = value; ijk_words |= (1<<AXIS_4); }
-            #endif
-            #ifdef AXIS_5
-              if (AXIS_5_NAME == 'X') { gc_block.values.ijk[AXIS_5] = value; ijk_words |= (1<<AXIS_5); }
-            #endif
-            #ifdef AXIS_6
-              if (AXIS_6_NAME == 'X') { gc_block.values.ijk[AXIS_6] = value; ijk_words |= (1<<AXIS_6); }
-            #endif
-            break;
-          case 'J':
-            dword_bit = DWORD_J;
-            if (AXIS_1_NAME == 'Y') { gc_block.values.ijk[AXIS_1] = value; ijk_words |= (1<<AXIS_1); }
-            if (AXIS_2_NAME == 'Y') { gc_block.values.ijk[AXIS_2] = value; ijk_words |= (1<<AXIS_2); }
-            if (AXIS_3_NAME == 'Y') { gc_block.values.ijk[AXIS_3] = value; ijk_words |= (1<<AXIS_3); }
-            #ifdef AXIS_4
-              if (AXIS_4_NAME == 'Y') { gc_block.values.ijk[AXIS_4] = value; ijk_words |= (1<<AXIS_4); }
-            #endif
-            #ifdef AXIS_5
-              if (AXIS_5_NAME == 'Y') { gc_block.values.ijk[AXIS_5] = value; ijk_words |= (1<<AXIS_5); }
-            #endif
-            #ifdef AXIS_6
-              if (AXIS_6_NAME == 'Y') { gc_block.values.ijk[AXIS_6] = value; ijk_words |= (1<<AXIS_6); }
-            #endif
-            break;
-          case 'K':
-            dword_bit = DWORD_K;
-            if (AXIS_1_NAME == 'Z') { gc_block.values.ijk[AXIS_1] = value; ijk_words |= (1<<AXIS_1); }
-            if (AXIS_2_NAME == 'Z') { gc_block.values.ijk[AXIS_2] = value; ijk_words |= (1<<AXIS_2); }
-            if (AXIS_3_NAME == 'Z') { gc_block.values.ijk[AXIS_3] = value; ijk_words |= (1<<AXIS_3); }
-            #ifdef AXIS_4
-              if (AXIS_4_NAME == 'Z') { gc_block.values.ijk[AXIS_4] = value; ijk_words |= (1<<AXIS_4); }
-            #endif
-            #ifdef AXIS_5
-              if (AXIS_5_NAME == 'Z') { gc_block.values.ijk[AXIS_5] = value; ijk_words |= (1<<AXIS_5); }
-            #endif
-            #ifdef AXIS_6
-              if (AXIS_6_NAME == 'Z') { gc_block.values.ijk[AXIS_6] = value; ijk_words |= (1<<AXIS_6); }
-            #endif
+          case 'I': case 'J': case 'K':
+            // Offset words apply to all the axes named X, Y and Z respectively, clones included.
+            dword_bit = DWORD_I+(letter-'I');
+            axis_mask = get_axis_letter_mask(letter+('X'-'I'));
+            for (idx=0; idx<N_AXIS; idx++) {
+              if (bit_istrue(axis_mask,bit(idx))) { gc_block.values.ijk[idx] = value; }
+            }
+            ijk_words |= axis_mask;
             break;
           case 'L': dword_bit = DWORD_L; gc_block.values.l = int_value; break;
-          case 'N': dword_bit = DWORD_N; gc_block.values.n = int_value;break;
-          // case 'O': // Not supported
+          case 'N': dword_bit = DWORD_N; gc_block.values.n = int_part; break;
+          // case 'O': // O-word lines are handled by oword_execute_line()
           case 'P': dword_bit = DWORD_P;
             // NOTE: For certain commands, P value must be an integer, This is the case of Digital output M26-M65
             if ((gc_block.non_modal_command >= NON_MODAL_DIGITAL_SYNC_ON) && (gc_block.non_modal_command <= NON_MODAL_DIGITAL_IMMEDIATE_OFF)) {
@@ -396,44 +492,12 @@ uint8_t gc_execute_line(char *line)
           // case imposible because same name can be used more than one for axis cloning
           // case AXIS_1_NAME: case AXIS_2_NAME: case AXIS_3_NAME: case AXIS_4_NAME: case AXIS_5_NAME: case AXIS_6_NAME:
           default:
-            if (letter == AXIS_1_NAME) {
-              dword_bit = DWORD_X; gc_block.values.xyz[AXIS_1] = value; axis_dwords |= (1<<AXIS_1);
-            }
-            if (letter == AXIS_2_NAME) {
-              dword_bit = DWORD_Y; gc_block.values.xyz[AXIS_2] = value; axis_dwords |= (1<<AXIS_2);
-            }
-            if (letter == AXIS_3_NAME) {
-              dword_bit = DWORD_Z; gc_block.values.xyz[AXIS_3] = value; axis_dwords |= (1<<AXIS_3);
-            }
-            #ifdef AXIS_4
-              if (letter == AXIS_4_NAME) {
-                dword_bit = DWORD_A; gc_block.values.xyz[AXIS_4] = value; axis_dwords |= (1<<AXIS_4);
-              }
-            #endif
-            #ifdef AXIS_5
-              if (letter == AXIS_5_NAME) {
-                dword_bit = DWORD_B; gc_block.values.xyz[AXIS_5] = value; axis_dwords |= (1<<AXIS_5);
-              }
-            #endif
-            #ifdef AXIS_6
-              if (letter == AXIS_6_NAME) {
-                dword_bit = DWORD_C; gc_block.values.xyz[AXIS_6] = value; axis_dwords |= (1<<AXIS_6);
-              }
-            #endif
-            // Error if letter is not an axis name
-            if ((letter != AXIS_1_NAME) && (letter != AXIS_2_NAME) && (letter != AXIS_3_NAME)
-            #ifdef AXIS_4
-              && (letter != AXIS_4_NAME)
-            #endif
-            #ifdef AXIS_5
-              && (letter != AXIS_5_NAME)
-            #endif
-            #ifdef AXIS_6
-              && (letter != AXIS_6_NAME)
-            #endif
-            ) {
-              FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND);
+            axis_mask = get_axis_letter_mask(letter);
+            if (!axis_mask) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [Letter is not an axis name]
+            for (idx=0; idx<N_AXIS; idx++) {
+              if (bit_istrue(axis_mask,bit(idx))) { dword_bit = DWORD_X+idx; gc_block.values.xyz[idx] = value; }
             }
+            axis_dwords |= axis_mask;
         }
 
         // NOTE: Variable 'dword_bit' is always assigned, if the non-command letter is valid.
@@ -577,214 +641,21 @@ uint8_t gc_execute_line(char *line)
 
   // [11. Set active plane ]:
   switch (gc_block.modal.plane_select) {
-    case PLANE_SELECT_XY: /* axis_0 = X axis, axis_1 = Y axis, axis_linear = Z axis */
-      if (AXIS_1_NAME == 'X') { axis_0_mask |= (1<<AXIS_1); axis_0 = AXIS_1; }
-      if (AXIS_2_NAME == 'X') { axis_0_mask |= (1<<AXIS_2); axis_0 = AXIS_2; }
-      if (AXIS_3_NAME == 'X') { axis_0_mask |= (1<<AXIS_3); axis_0 = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'X') { axis_0_mask |= (1<<AXIS_4); axis_0 = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'X') { axis_0_mask |= (1<<AXIS_5); axis_0 = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'X') { axis_0_mask |= (1<<AXIS_6); axis_0 = AXIS_6; }
-      #endif
-
-      if (AXIS_1_NAME == 'Y') { axis_1_mask |= (1<<AXIS_1); axis_1 = AXIS_1; }
-      if (AXIS_2_NAME == 'Y') { axis_1_mask |= (1<<AXIS_2); axis_1 = AXIS_2; }
-      if (AXIS_3_NAME == 'Y') { axis_1_mask |= (1<<AXIS_3); axis_1 = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'Y') { axis_1_mask |= (1<<AXIS_4); axis_1 = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'Y') { axis_1_mask |= (1<<AXIS_5); axis_1 = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'Y') { axis_1_mask |= (1<<AXIS_6); axis_1 = AXIS_6; }
-      #endif
-
-      if (AXIS_1_NAME == 'Z') { axis_linear_mask |= (1<<AXIS_1); axis_linear = AXIS_1; }
-      if (AXIS_2_NAME == 'Z') { axis_linear_mask |= (1<<AXIS_2); axis_linear = AXIS_2; }
-      if (AXIS_3_NAME == 'Z') { axis_linear_mask |= (1<<AXIS_3); axis_linear = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'Z') { axis_linear_mask |= (1<<AXIS_4); axis_linear = AXIS_4; }
-        else if (AXIS_4_NAME == 'A') { axis_a_mask |= (1<<AXIS_4); axis_a = AXIS_4; }
-        else if (AXIS_4_NAME == 'B') { axis_b_mask |= (1<<AXIS_4); axis_b = AXIS_4; }
-        else if (AXIS_4_NAME == 'C') { axis_c_mask |= (1<<AXIS_4); axis_c = AXIS_4; }
-        else if (AXIS_4_NAME == 'U') { axis_u_mask |= (1<<AXIS_4); axis_u = AXIS_4; }
-        else if (AXIS_4_NAME == 'V') { axis_v_mask |= (1<<AXIS_4); axis_v = AXIS_4; }
-        else if (AXIS_4_NAME == 'W') { axis_w_mask |= (1<<AXIS_4); axis_w = AXIS_4; }
-        else if (AXIS_4_NAME == 'D') { axis_d_mask |= (1<<AXIS_4); axis_d = AXIS_4; }
-        else if (AXIS_4_NAME == 'E') { axis_e_mask |= (1<<AXIS_4); axis_e = AXIS_4; }
-        else if (AXIS_4_NAME == 'H') { axis_h_mask |= (1<<AXIS_4); axis_h = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'Z') { axis_linear_mask |= (1<<AXIS_5); axis_linear = AXIS_5; }
-        else if (AXIS_5_NAME == 'A') { axis_a_mask |= (1<<AXIS_5); axis_a = AXIS_5; }
-        else if (AXIS_5_NAME == 'B') { axis_b_mask |= (1<<AXIS_5); axis_b = AXIS_5; }
-        else if (AXIS_5_NAME == 'C') { axis_c_mask |= (1<<AXIS_5); axis_c = AXIS_5; }
-        else if (AXIS_5_NAME == 'U') { axis_u_mask |= (1<<AXIS_5); axis_u = AXIS_5; }
-        else if (AXIS_5_NAME == 'V') { axis_v_mask |= (1<<AXIS_5); axis_v = AXIS_5; }
-        else if (AXIS_5_NAME == 'W') { axis_w_mask |= (1<<AXIS_5); axis_w = AXIS_5; }
-        else if (AXIS_5_NAME == 'D') { axis_d_mask |= (1<<AXIS_5); axis_d = AXIS_5; }
-        else if (AXIS_5_NAME == 'E') { axis_e_mask |= (1<<AXIS_5); axis_e = AXIS_5; }
-        else if (AXIS_5_NAME == 'H') { axis_h_mask |= (1<<AXIS_5); axis_h = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'Z') { axis_linear_mask |= (1<<AXIS_6); axis_linear = AXIS_6; }
-        else if (AXIS_6_NAME == 'A') { axis_a_mask |= (1<<AXIS_6); axis_a = AXIS_6; }
-        else if (AXIS_6_NAME == 'B') { axis_b_mask |= (1<<AXIS_6); axis_b = AXIS_6; }
-        else if (AXIS_6_NAME == 'C') { axis_c_mask |= (1<<AXIS_6); axis_c = AXIS_6; }
-        else if (AXIS_6_NAME == 'U') { axis_u_mask |= (1<<AXIS_6); axis_u = AXIS_6; }
-        else if (AXIS_6_NAME == 'V') { axis_v_mask |= (1<<AXIS_6); axis_v = AXIS_6; }
-        else if (AXIS_6_NAME == 'W') { axis_w_mask |= (1<<AXIS_6); axis_w = AXIS_6; }
-        else if (AXIS_6_NAME == 'D') { axis_d_mask |= (1<<AXIS_6); axis_d = AXIS_6; }
-        else if (AXIS_6_NAME == 'E') { axis_e_mask |= (1<<AXIS_6); axis_e = AXIS_6; }
-        else if (AXIS_6_NAME == 'H') { axis_h_mask |= (1<<AXIS_6); axis_h = AXIS_6; }
-      #endif
+    case PLANE_SELECT_XY: /* axis_0 = X axis, axis_1 = Y axis */
+      axis_0 = AXIS_LETTER_INDEX('X'); axis_0_mask = AXIS_LETTER_MASK('X');
+      axis_1 = AXIS_LETTER_INDEX('Y'); axis_1_mask = AXIS_LETTER_MASK('Y');
       break;
-
-    case PLANE_SELECT_ZX: /* axis_0 = Z axis, axis_1 = X axis, axis_linear = Y axis */
-      if (AXIS_1_NAME == 'Z') { axis_0_mask |= (1<<AXIS_1); axis_0 = AXIS_1; }
-      if (AXIS_2_NAME == 'Z') { axis_0_mask |= (1<<AXIS_2); axis_0 = AXIS_2; }
-      if (AXIS_3_NAME == 'Z') { axis_0_mask |= (1<<AXIS_3); axis_0 = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'Z') { axis_0_mask |= (1<<AXIS_4); axis_0 = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'Z') { axis_0_mask |= (1<<AXIS_5); axis_0 = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'Z') { axis_0_mask |= (1<<AXIS_6); axis_0 = AXIS_6; }
-      #endif
-
-      if (AXIS_1_NAME == 'X') { axis_1_mask |= (1<<AXIS_1); axis_1 = AXIS_1; }
-      if (AXIS_2_NAME == 'X') { axis_1_mask |= (1<<AXIS_2); axis_1 = AXIS_2; }
-      if (AXIS_3_NAME == 'X') { axis_1_mask |= (1<<AXIS_3); axis_1 = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'X') { axis_1_mask |= (1<<AXIS_4); axis_1 = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'X') { axis_1_mask |= (1<<AXIS_5); axis_1 = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'X') { axis_1_mask |= (1<<AXIS_6); axis_1 = AXIS_6; }
-      #endif
-
-      if (AXIS_1_NAME == 'Y') { axis_linear_mask |= (1<<AXIS_1); axis_linear = AXIS_1; }
-      if (AXIS_2_NAME == 'Y') { axis_linear_mask |= (1<<AXIS_2); axis_linear = AXIS_2; }
-      if (AXIS_3_NAME == 'Y') { axis_linear_mask |= (1<<AXIS_3); axis_linear = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'Y') { axis_linear_mask |= (1<<AXIS_4); axis_linear = AXIS_4; }
-        else if (AXIS_4_NAME == 'A') { axis_a_mask |= (1<<AXIS_4); axis_a = AXIS_4; }
-        else if (AXIS_4_NAME == 'B') { axis_b_mask |= (1<<AXIS_4); axis_b = AXIS_4; }
-        else if (AXIS_4_NAME == 'C') { axis_c_mask |= (1<<AXIS_4); axis_c = AXIS_4; }
-        else if (AXIS_4_NAME == 'U') { axis_u_mask |= (1<<AXIS_4); axis_u = AXIS_4; }
-        else if (AXIS_4_NAME == 'V') { axis_v_mask |= (1<<AXIS_4); axis_v = AXIS_4; }
-        else if (AXIS_4_NAME == 'W') { axis_w_mask |= (1<<AXIS_4); axis_w = AXIS_4; }
-        else if (AXIS_4_NAME == 'D') { axis_d_mask |= (1<<AXIS_4); axis_d = AXIS_4; }
-        else if (AXIS_4_NAME == 'E') { axis_e_mask |= (1<<AXIS_4); axis_e = AXIS_4; }
-        else if (AXIS_4_NAME == 'H') { axis_h_mask |= (1<<AXIS_4); axis_h = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'Y') { axis_linear_mask |= (1<<AXIS_5); axis_linear = AXIS_5; }
-        else if (AXIS_5_NAME == 'A') { axis_a_mask |= (1<<AXIS_5); axis_a = AXIS_5; }
-        else if (AXIS_5_NAME == 'B') { axis_b_mask |= (1<<AXIS_5); axis_b = AXIS_5; }
-        else if (AXIS_5_NAME == 'C') { axis_c_mask |= (1<<AXIS_5); axis_c = AXIS_5; }
-        else if (AXIS_5_NAME == 'U') { axis_u_mask |= (1<<AXIS_5); axis_u = AXIS_5; }
-        else if (AXIS_5_NAME == 'V') { axis_v_mask |= (1<<AXIS_5); axis_v = AXIS_5; }
-        else if (AXIS_5_NAME == 'W') { axis_w_mask |= (1<<AXIS_5); axis_w = AXIS_5; }
-        else if (AXIS_5_NAME == 'D') { axis_d_mask |= (1<<AXIS_5); axis_d = AXIS_5; }
-        else if (AXIS_5_NAME == 'E') { axis_e_mask |= (1<<AXIS_5); axis_e = AXIS_5; }
-        else if (AXIS_5_NAME == 'H') { axis_h_mask |= (1<<AXIS_5); axis_h = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'Y') { axis_linear_mask |= (1<<AXIS_6); axis_linear = AXIS_6; }
-        else if (AXIS_6_NAME == 'A') { axis_a_mask |= (1<<AXIS_6); axis_a = AXIS_6; }
-        else if (AXIS_6_NAME == 'B') { axis_b_mask |= (1<<AXIS_6); axis_b = AXIS_6; }
-        else if (AXIS_6_NAME == 'C') { axis_c_mask |= (1<<AXIS_6); axis_c = AXIS_6; }
-        else if (AXIS_6_NAME == 'U') { axis_u_mask |= (1<<AXIS_6); axis_u = AXIS_6; }
-        else if (AXIS_6_NAME == 'V') { axis_v_mask |= (1<<AXIS_6); axis_v = AXIS_6; }
-        else if (AXIS_6_NAME == 'W') { axis_w_mask |= (1<<AXIS_6); axis_w = AXIS_6; }
-        else if (AXIS_6_NAME == 'D') { axis_d_mask |= (1<<AXIS_6); axis_d = AXIS_6; }
-        else if (AXIS_6_NAME == 'E') { axis_e_mask |= (1<<AXIS_6); axis_e = AXIS_6; }
-        else if (AXIS_6_NAME == 'H') { axis_h_mask |= (1<<AXIS_6); axis_h = AXIS_6; }
-      #endif
+    case PLANE_SELECT_ZX: /* axis_0 = Z axis, axis_1 = X axis */
+      axis_0 = AXIS_LETTER_INDEX('Z'); axis_0_mask = AXIS_LETTER_MASK('Z');
+      axis_1 = AXIS_LETTER_INDEX('X'); axis_1_mask = AXIS_LETTER_MASK('X');
       break;
-
-    default: /* case PLANE_SELECT_YZ: axis_0 = Y axis, axis_1 = Z axis, axis_linear = X axis */
-      if (AXIS_1_NAME == 'Y') { axis_0_mask |= (1<<AXIS_1); axis_0 = AXIS_1; }
-      if (AXIS_2_NAME == 'Y') { axis_0_mask |= (1<<AXIS_2); axis_0 = AXIS_2; }
-      if (AXIS_3_NAME == 'Y') { axis_0_mask |= (1<<AXIS_3); axis_0 = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'Y') { axis_0_mask |= (1<<AXIS_4); axis_0 = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'Y') { axis_0_mask |= (1<<AXIS_5); axis_0 = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'Y') { axis_0_mask |= (1<<AXIS_6); axis_0 = AXIS_6; }
-      #endif
-
-      if (AXIS_1_NAME == 'Z') { axis_1_mask |= (1<<AXIS_1); axis_1 = AXIS_1; }
-      if (AXIS_2_NAME == 'Z') { axis_1_mask |= (1<<AXIS_2); axis_1 = AXIS_2; }
-      if (AXIS_3_NAME == 'Z') { axis_1_mask |= (1<<AXIS_3); axis_1 = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'Z') { axis_1_mask |= (1<<AXIS_4); axis_1 = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'Z') { axis_1_mask |= (1<<AXIS_5); axis_1 = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'Z') { axis_1_mask |= (1<<AXIS_6); axis_1 = AXIS_6; }
-      #endif
-
-      if (AXIS_1_NAME == 'X') { axis_linear_mask |= (1<<AXIS_1); axis_linear = AXIS_1; }
-      if (AXIS_2_NAME == 'X') { axis_linear_mask |= (1<<AXIS_2); axis_linear = AXIS_2; }
-      if (AXIS_3_NAME == 'X') { axis_linear_mask |= (1<<AXIS_3); axis_linear = AXIS_3; }
-      #ifdef AXIS_4
-        if (AXIS_4_NAME == 'X') { axis_linear_mask |= (1<<AXIS_4); axis_linear = AXIS_4; }
-        else if (AXIS_4_NAME == 'A') { axis_a_mask |= (1<<AXIS_4); axis_a = AXIS_4; }
-        else if (AXIS_4_NAME == 'B') { axis_b_mask |= (1<<AXIS_4); axis_b = AXIS_4; }
-        else if (AXIS_4_NAME == 'C') { axis_c_mask |= (1<<AXIS_4); axis_c = AXIS_4; }
-        else if (AXIS_4_NAME == 'U') { axis_u_mask |= (1<<AXIS_4); axis_u = AXIS_4; }
-        else if (AXIS_4_NAME == 'V') { axis_v_mask |= (1<<AXIS_4); axis_v = AXIS_4; }
-        else if (AXIS_4_NAME == 'W') { axis_w_mask |= (1<<AXIS_4); axis_w = AXIS_4; }
-        else if (AXIS_4_NAME == 'D') { axis_d_mask |= (1<<AXIS_4); axis_d = AXIS_4; }
-        else if (AXIS_4_NAME == 'E') { axis_e_mask |= (1<<AXIS_4); axis_e = AXIS_4; }
-        else if (AXIS_4_NAME == 'H') { axis_h_mask |= (1<<AXIS_4); axis_h = AXIS_4; }
-      #endif
-      #ifdef AXIS_5
-        if (AXIS_5_NAME == 'X') { axis_linear_mask |= (1<<AXIS_5); axis_linear = AXIS_5; }
-        else if (AXIS_5_NAME == 'A') { axis_a_mask |= (1<<AXIS_5); axis_a = AXIS_5; }
-        else if (AXIS_5_NAME == 'B') { axis_b_mask |= (1<<AXIS_5); axis_b = AXIS_5; }
-        else if (AXIS_5_NAME == 'C') { axis_c_mask |= (1<<AXIS_5); axis_c = AXIS_5; }
-        else if (AXIS_5_NAME == 'U') { axis_u_mask |= (1<<AXIS_5); axis_u = AXIS_5; }
-        else if (AXIS_5_NAME == 'V') { axis_v_mask |= (1<<AXIS_5); axis_v = AXIS_5; }
-        else if (AXIS_5_NAME == 'W') { axis_w_mask |= (1<<AXIS_5); axis_w = AXIS_5; }
-        else if (AXIS_5_NAME == 'D') { axis_d_mask |= (1<<AXIS_5); axis_d = AXIS_5; }
-        else if (AXIS_5_NAME == 'E') { axis_e_mask |= (1<<AXIS_5); axis_e = AXIS_5; }
-        else if (AXIS_5_NAME == 'H') { axis_h_mask |= (1<<AXIS_5); axis_h = AXIS_5; }
-      #endif
-      #ifdef AXIS_6
-        if (AXIS_6_NAME == 'X') { axis_linear_mask |= (1<<AXIS_6); axis_linear = AXIS_6; }
-        else if (AXIS_6_NAME == 'A') { axis_a_mask |= (1<<AXIS_6); axis_a = AXIS_6; }
-        else if (AXIS_6_NAME == 'B') { axis_b_mask |= (1<<AXIS_6); axis_b = AXIS_6; }
-        else if (AXIS_6_NAME == 'C') { axis_c_mask |= (1<<AXIS_6); axis_c = AXIS_6; }
-        else if (AXIS_6_NAME == 'U') { axis_u_mask |= (1<<AXIS_6); axis_u = AXIS_6; }
-        else if (AXIS_6_NAME == 'V') { axis_v_mask |= (1<<AXIS_6); axis_v = AXIS_6; }
-        else if (AXIS_6_NAME == 'W') { axis_w_mask |= (1<<AXIS_6); axis_w = AXIS_6; }
-        else if (AXIS_6_NAME == 'D') { axis_d_mask |= (1<<AXIS_6); axis_d = AXIS_6; }
-        else if (AXIS_6_NAME == 'E') { axis_e_mask |= (1<<AXIS_6); axis_e = AXIS_6; }
-        else if (AXIS_6_NAME == 'H') { axis_h_mask |= (1<<AXIS_6); axis_h = AXIS_6; }
-      #endif
-
+    default: /* case PLANE_SELECT_YZ: axis_0 = Y axis, axis_1 = Z axis */
+      axis_0 = AXIS_LETTER_INDEX('Y'); axis_0_mask = AXIS_LETTER_MASK('Y');
+      axis_1 = AXIS_LETTER_INDEX('Z'); axis_1_mask = AXIS_LETTER_MASK('Z');
   }
 
   // [12. Set length units ]: N/A
   // Pre-convert XYZ coordinate values to millimeters, if applicable.
-  uint8_t idx;
   if (gc_block.modal.units == UNITS_MODE_INCHES) {
     #if N_AXIS > 3
       for (idx=0; idx<N_AXIS_LINEAR; idx++) { // Axes indices are consistent, so loop may be used.
@@ -814,13 +685,23 @@ uint8_t gc_execute_line(char *line)
   }
 
   // [15. Coordinate system selection ]: *N/A. Error, if cutter radius comp is active.
-  // TODO: An EEPROM read of the coordinate data may require a buffer sync when the cycle
-  // is active. The read pauses the processor temporarily and may cause a rare crash. For
-  // future versions on processors with enough memory, all coordinate data should be stored
-  // in memory and written to EEPROM only when there is not a cycle active.
+  // NOTE: All coordinate data is cached in RAM upon startup, so selecting a coordinate system
+  // never reads EEPROM, even while a cycle is active.
   float block_coord_system[N_AXIS];
   memcpy(block_coord_system,gc_state.coord_system,sizeof(gc_state.coord_system));
   if ( bit_istrue(command_dwords,bit(MODAL_GROUP_G12)) ) { // Check if called in block
+    #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+      // [G54.1 Errors]: P word missing. P value not an integer. P value not 1 to nExtendedCoordSys.
+      if (gc_block.modal.coord_select == SETTING_INDEX_EXTENDED) {
+        if (bit_isfalse(value_dwords,dwbit(DWORD_P))) { FAIL(STATUS_GCODE_VALUE_WORD_MISSING); } // [P word missing]
+        if (gc_block.values.p != trunc(gc_block.values.p)) { FAIL(STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER); } // [P not an integer]
+        if ((gc_block.values.p < 1) || (gc_block.values.p >= N_EXTENDED_COORDINATE_SYSTEM+1)) {
+          FAIL(STATUS_GCODE_UNSUPPORTED_COORD_SYS); // [P out of range]
+        }
+        gc_block.modal.coord_select += trunc(gc_block.values.p)-1; // Index P1 as the first extended system.
+        bit_false(value_dwords,dwbit(DWORD_P));
+      } else
+    #endif
     if (gc_block.modal.coord_select > N_COORDINATE_SYSTEM) { FAIL(STATUS_GCODE_UNSUPPORTED_COORD_SYS); } // [Greater than N sys]
     if (gc_state.modal.coord_select != gc_block.modal.coord_select) {
       if (!(settings_read_coord_data(gc_block.modal.coord_select,block_coord_system))) { FAIL(STATUS_SETTING_READ_FAIL); }
@@ -874,6 +755,14 @@ uint8_t gc_execute_line(char *line)
           }
         } // Else, keep current stored value.
       }
+      #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+        // [G54.1 system offset beyond its 24-bit micron storage]
+        if (coord_select >= SETTING_INDEX_EXTENDED) {
+          for (idx=0; idx<N_AXIS; idx++) {
+            if (fabs(gc_block.values.ijk[idx]) > 8388.6) { FAIL(STATUS_GCODE_MAX_VALUE_EXCEEDED); }
+          }
+        }
+      #endif
       break;
     case NON_MODAL_SET_COORDINATE_OFFSET:
       // [G92 Errors]: No axis words.
@@ -949,6 +838,28 @@ uint8_t gc_execute_line(char *line)
         case NON_MODAL_RESET_COORDINATE_OFFSET:
           // NOTE: If axis words are passed here, they are interpreted as an implicit motion mode.
           break;
+        #ifdef ENABLE_COORD_TRANSFORM
+          case NON_MODAL_SET_TRANSFORM: // G68
+            // [G68 Errors]: X or Y axis not configured. Axis words other than XY. Scale not positive.
+            //   Skew of 45 degrees or more.
+            // NOTE: XY give the center, following the distance mode, and default to the current position.
+            //   R is the counterclockwise rotation and K the skew of X along Y, in degrees. I and J are
+            //   the X and Y scales, set here to 1 when missing. A missing K is zero.
+            if (!(AXIS_LETTER_MASK('X') && AXIS_LETTER_MASK('Y'))) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); }
+            if (axis_dwords & ~(AXIS_LETTER_MASK('X')|AXIS_LETTER_MASK('Y'))) { FAIL(STATUS_GCODE_UNUSED_WORDS); }
+            if (!axis_dwords) { // The target above is only computed with axis words. Center on the current position.
+              gc_block.values.xyz[AXIS_LETTER_INDEX('X')] = gc_state.position[AXIS_LETTER_INDEX('X')];
+              gc_block.values.xyz[AXIS_LETTER_INDEX('Y')] = gc_state.position[AXIS_LETTER_INDEX('Y')];
+            }
+            if (!(ijk_words & AXIS_LETTER_MASK('X'))) { gc_block.values.ijk[AXIS_LETTER_INDEX('X')] = 1.0; }
+            if (!(ijk_words & AXIS_LETTER_MASK('Y'))) { gc_block.values.ijk[AXIS_LETTER_INDEX('Y')] = 1.0; }
+            if ((gc_block.values.ijk[AXIS_LETTER_INDEX('X')] <= 0.0) || (gc_block.values.ijk[AXIS_LETTER_INDEX('Y')] <= 0.0)) {
+              FAIL(STATUS_GCODE_INVALID_TARGET); // [Scale not positive]
+            }
+            if (AXIS_LETTER_MASK('Z') && (fabs(gc_block.values.ijk[AXIS_LETTER_INDEX('Z')]) >= 45.0)) { FAIL(STATUS_GCODE_MAX_VALUE_EXCEEDED); }
+            bit_false(value_dwords,(dwbit(DWORD_I)|dwbit(DWORD_J)|dwbit(DWORD_K)|dwbit(DWORD_R)));
+            break;
+        #endif
         case NON_MODAL_ABSOLUTE_OVERRIDE:
           // [G53 Errors]: G0 and G1 are not active. Cutter compensation is enabled.
           // NOTE: All explicit axis word commands are in this modal group. So no implicit check necessary.
@@ -956,6 +867,70 @@ uint8_t gc_execute_line(char *line)
             FAIL(STATUS_GCODE_G53_INVALID_MOTION_MODE); // [G53 G0/1 not active]
           }
           break;
+        #ifdef ENABLE_WELL_PLATE_CYCLE
+          case NON_MODAL_PLATE_CYCLE: // G70
+            // [G70 Errors]: X, Y or Z axis not configured. Z word missing. Axis words other than XYZ. G93 active.
+            //   Feed rate undefined. R word missing or below Z. P not 1 to 255. L is zero. I word missing with
+            //   P>1. J word missing with L>1. A corner well exceeds the soft limits.
+            // NOTE: XYZ give the first well at depth, following the distance mode. R is the retract height,
+            //   from the current Z in incremental mode. I and J are the column and row pitch. P and L are
+            //   the numbers of columns and rows. Store the grid in the P, L, R and IJ values for mc_plate_cycle().
+            if (!(AXIS_LETTER_MASK('X') && AXIS_LETTER_MASK('Y') && AXIS_LETTER_MASK('Z'))) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); }
+            if (!(axis_dwords & AXIS_LETTER_MASK('Z'))) { FAIL(STATUS_GCODE_NO_AXIS_WORDS); } // [Z word missing]
+            if (axis_dwords & ~(AXIS_LETTER_MASK('X')|AXIS_LETTER_MASK('Y')|AXIS_LETTER_MASK('Z'))) { FAIL(STATUS_GCODE_UNUSED_WORDS); }
+            if (gc_block.modal.feed_rate == FEED_RATE_MODE_INVERSE_TIME) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G93 active]
+            if (gc_block.values.f == 0.0) { FAIL(STATUS_GCODE_UNDEFINED_FEED_RATE); } // [Feed rate undefined]
+            if (bit_isfalse(value_dwords,dwbit(DWORD_R))) { FAIL(STATUS_GCODE_VALUE_WORD_MISSING); } // [R word missing]
+            if (bit_isfalse(value_dwords,dwbit(DWORD_P))) { gc_block.values.p = 1; }
+            if (bit_isfalse(value_dwords,dwbit(DWORD_L))) { gc_block.values.l = 1; }
+            if ((gc_block.values.p < 1) || (gc_block.values.l == 0)) { FAIL(STATUS_GCODE_INVALID_TARGET); } // [Empty grid]
+            if (gc_block.values.p > 255) { FAIL(STATUS_GCODE_MAX_VALUE_EXCEEDED); }
+            gc_block.values.p = trunc(gc_block.values.p);
+            if ((gc_block.values.p > 1) && !(ijk_words & AXIS_LETTER_MASK('X'))) { FAIL(STATUS_GCODE_VALUE_WORD_MISSING); } // [I word missing]
+            if ((gc_block.values.l > 1) && !(ijk_words & AXIS_LETTER_MASK('Y'))) { FAIL(STATUS_GCODE_VALUE_WORD_MISSING); } // [J word missing]
+            bit_false(value_dwords,(dwbit(DWORD_I)|dwbit(DWORD_J)|dwbit(DWORD_L)|dwbit(DWORD_P)|dwbit(DWORD_R)));
+
+            // Convert the pitches and the retract height to millimeters. Then store the retract height as
+            // the rise above the well depth, on the first Z axis. Cloned Z axes keep the same rise.
+            if (gc_block.modal.units == UNITS_MODE_INCHES) {
+              gc_block.values.r *= MM_PER_INCH;
+              gc_block.values.ijk[AXIS_LETTER_INDEX('X')] *= MM_PER_INCH;
+              gc_block.values.ijk[AXIS_LETTER_INDEX('Y')] *= MM_PER_INCH;
+            }
+            idx = AXIS_LETTER_INDEX('Z');
+            if (gc_block.modal.distance == DISTANCE_MODE_ABSOLUTE) {
+              gc_block.values.r += block_coord_system[idx] + gc_state.coord_offset[idx];
+              if (idx == TOOL_LENGTH_OFFSET_AXIS) { gc_block.values.r += gc_state.tool_length_offset; }
+            } else {
+              gc_block.values.r += gc_state.position[idx];
+            }
+            gc_block.values.r -= gc_block.values.xyz[idx];
+            if (gc_block.values.r < 0.0) { FAIL(STATUS_GCODE_INVALID_TARGET); } // [R below Z]
+
+            // Check the box of the wells, from depth to retract height, against the soft limits up front, once
+            // compensated. Otherwise, a soft limit alarm could stop the cycle halfway through the plate.
+            if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) {
+              float box_min[N_AXIS];
+              float box_max[N_AXIS];
+              for (idx=0; idx<N_AXIS; idx++) {
+                box_min[idx] = gc_block.values.xyz[idx];
+                box_max[idx] = gc_block.values.xyz[idx];
+                if (bit_istrue(AXIS_LETTER_MASK('X'),bit(idx))) {
+                  box_max[idx] += (gc_block.values.p-1)*gc_block.values.ijk[AXIS_LETTER_INDEX('X')];
+                } else if (bit_istrue(AXIS_LETTER_MASK('Y'),bit(idx))) {
+                  box_max[idx] += (gc_block.values.l-1)*gc_block.values.ijk[AXIS_LETTER_INDEX('Y')];
+                } else if (bit_istrue(AXIS_LETTER_MASK('Z'),bit(idx))) {
+                  box_max[idx] += gc_block.values.r;
+                }
+                if (box_max[idx] < box_min[idx]) { // Negative spacing
+                  box_min[idx] = box_max[idx];
+                  box_max[idx] = gc_block.values.xyz[idx];
+                }
+              }
+              if (mc_check_travel_limits_box(box_min, box_max)) { FAIL(STATUS_TRAVEL_EXCEEDED); }
+            }
+            break;
+        #endif
       }
   }
 
@@ -1092,90 +1067,11 @@ uint8_t gc_execute_line(char *line)
                 h_x2_div_d = -h_x2_div_d;
                 gc_block.values.r = -gc_block.values.r; // Finished with r. Set to positive for mc_arc
             }
-            // Complete the operation by calculating the actual center of the arc
-            /*gc_block.values.ijk[axis_0] = 0.5*(x-(y*h_x2_div_d));
-            gc_block.values.ijk[axis_1] = 0.5*(y+(x*h_x2_div_d));*/
-            switch (gc_block.modal.plane_select) {
-              case PLANE_SELECT_XY:
-                if (AXIS_1_NAME == 'X') { gc_block.values.ijk[AXIS_1] = 0.5*(x-(y*h_x2_div_d)); }
-                if (AXIS_2_NAME == 'X') { gc_block.values.ijk[AXIS_2] = 0.5*(x-(y*h_x2_div_d)); }
-                if (AXIS_3_NAME == 'X') { gc_block.values.ijk[AXIS_3] = 0.5*(x-(y*h_x2_div_d)); }
-                #ifdef AXIS_4
-                  if (AXIS_4_NAME == 'X') { gc_block.values.ijk[AXIS_4] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_5
-                  if (AXIS_5_NAME == 'X') { gc_block.values.ijk[AXIS_5] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_6
-                  if (AXIS_6_NAME == 'X') { gc_block.values.ijk[AXIS_6] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                if (AXIS_1_NAME == 'Y') { gc_block.values.ijk[AXIS_1] = 0.5*(y+(x*h_x2_div_d)); }
-                if (AXIS_2_NAME == 'Y') { gc_block.values.ijk[AXIS_2] = 0.5*(y+(x*h_x2_div_d)); }
-                if (AXIS_3_NAME == 'Y') { gc_block.values.ijk[AXIS_3] = 0.5*(y+(x*h_x2_div_d)); }
-                #ifdef AXIS_4
-                  if (AXIS_4_NAME == 'Y') { gc_block.values.ijk[AXIS_4] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_5
-                  if (AXIS_5_NAME == 'Y') { gc_block.values.ijk[AXIS_5] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_6
-                  if (AXIS_6_NAME == 'Y') { gc_block.values.ijk[AXIS_6] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-                break;
-
-              case PLANE_SELECT_ZX:
-                if (AXIS_1_NAME == 'Z') { gc_block.values.ijk[AXIS_1] = 0.5*(x-(y*h_x2_div_d)); }
-                if (AXIS_2_NAME == 'Z') { gc_block.values.ijk[AXIS_2] = 0.5*(x-(y*h_x2_div_d)); }
-                if (AXIS_3_NAME == 'Z') { gc_block.values.ijk[AXIS_3] = 0.5*(x-(y*h_x2_div_d)); }
-                #ifdef AXIS_4
-                  if (AXIS_4_NAME == 'Z') { gc_block.values.ijk[AXIS_4] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_5
-                  if (AXIS_5_NAME == 'Z') { gc_block.values.ijk[AXIS_5] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_6
-                  if (AXIS_6_NAME == 'Z') { gc_block.values.ijk[AXIS_6] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                if (AXIS_1_NAME == 'X') { gc_block.values.ijk[AXIS_1] = 0.5*(y+(x*h_x2_div_d)); }
-                if (AXIS_2_NAME == 'X') { gc_block.values.ijk[AXIS_2] = 0.5*(y+(x*h_x2_div_d)); }
-                if (AXIS_3_NAME == 'X') { gc_block.values.ijk[AXIS_3] = 0.5*(y+(x*h_x2_div_d)); }
-                #ifdef AXIS_4
-                  if (AXIS_4_NAME == 'X') { gc_block.values.ijk[AXIS_4] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_5
-                  if (AXIS_5_NAME == 'X') { gc_block.values.ijk[AXIS_5] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_6
-                  if (AXIS_6_NAME == 'X') { gc_block.values.ijk[AXIS_6] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-                break;
-
-              default: // case PLANE_SELECT_YZ:
-                if (AXIS_1_NAME == 'Y') { gc_block.values.ijk[AXIS_1] = 0.5*(x-(y*h_x2_div_d)); }
-                if (AXIS_2_NAME == 'Y') { gc_block.values.ijk[AXIS_2] = 0.5*(x-(y*h_x2_div_d)); }
-                if (AXIS_3_NAME == 'Y') { gc_block.values.ijk[AXIS_3] = 0.5*(x-(y*h_x2_div_d)); }
-                #ifdef AXIS_4
-                  if (AXIS_4_NAME == 'Y') { gc_block.values.ijk[AXIS_4] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_5
-                  if (AXIS_5_NAME == 'Y') { gc_block.values.ijk[AXIS_5] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_6
-                  if (AXIS_6_NAME == 'Y') { gc_block.values.ijk[AXIS_6] = 0.5*(x-(y*h_x2_div_d)); }
-                #endif
-                if (AXIS_1_NAME == 'Z') { gc_block.values.ijk[AXIS_1] = 0.5*(y+(x*h_x2_div_d)); }
-                if (AXIS_2_NAME == 'Z') { gc_block.values.ijk[AXIS_2] = 0.5*(y+(x*h_x2_div_d)); }
-                if (AXIS_3_NAME == 'Z') { gc_block.values.ijk[AXIS_3] = 0.5*(y+(x*h_x2_div_d)); }
-                #ifdef AXIS_4
-                  if (AXIS_4_NAME == 'Z') { gc_block.values.ijk[AXIS_4] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_5
-                  if (AXIS_5_NAME == 'Z') { gc_block.values.ijk[AXIS_5] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-                #ifdef AXIS_6
-                  if (AXIS_6_NAME == 'Z') { gc_block.values.ijk[AXIS_6] = 0.5*(y+(x*h_x2_div_d)); }
-                #endif
-
+            // Complete the operation by calculating the actual center of the arc. Cloned plane axes get
+            // the same offset.
+            for (idx=0; idx<N_AXIS; idx++) {
+              if (bit_istrue(axis_0_mask,bit(idx))) { gc_block.values.ijk[idx] = 0.5*(x-(y*h_x2_div_d)); }
+              else if (bit_istrue(axis_1_mask,bit(idx))) { gc_block.values.ijk[idx] = 0.5*(y+(x*h_x2_div_d)); }
             }
 
           } else { // Arc Center Format Offset Mode
@@ -1220,6 +1116,25 @@ uint8_t gc_execute_line(char *line)
           //   allow the planner buffer to empty and move off the probe trigger before another probing cycle.
           if (!axis_dwords) { FAIL(STATUS_GCODE_NO_AXIS_WORDS); } // [No axis words]
           if (isequal_position_vector(gc_state.position, gc_block.values.xyz)) { FAIL(STATUS_GCODE_INVALID_TARGET); } // [Invalid target]
+          #ifdef ENABLE_TWO_STAGE_PROBE
+            // [G38 two-stage Errors]: R or P word missing. Inverse time mode. Slow feed rate is zero.
+            //   Retract distance is not positive. NOTE: P is already checked for negative values.
+            if (value_dwords & (dwbit(DWORD_P)|dwbit(DWORD_R))) {
+              if (bit_isfalse(value_dwords,dwbit(DWORD_P)) || bit_isfalse(value_dwords,dwbit(DWORD_R))) {
+                FAIL(STATUS_GCODE_VALUE_WORD_MISSING); // [R or P word missing]
+              }
+              if (gc_block.modal.feed_rate == FEED_RATE_MODE_INVERSE_TIME) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); }
+              if (gc_block.values.p == 0.0) { FAIL(STATUS_GCODE_UNDEFINED_FEED_RATE); } // [Slow feed rate undefined]
+              if (gc_block.values.r <= 0.0) { FAIL(STATUS_GCODE_INVALID_TARGET); } // [Retract must move]
+              if (gc_block.modal.units == UNITS_MODE_INCHES) {
+                gc_block.values.p *= MM_PER_INCH;
+                gc_block.values.r *= MM_PER_INCH;
+              }
+              bit_false(value_dwords,(dwbit(DWORD_P)|dwbit(DWORD_R)));
+            } else {
+              gc_block.values.r = 0.0; // Single-stage probe. Flags mc_probe_cycle in the execution.
+            }
+          #endif
           break;
       }
     }
@@ -1277,13 +1192,17 @@ uint8_t gc_execute_line(char *line)
     // Initialize planner data to current spindle and coolant modal state.
     pl_data->spindle_speed = gc_state.spindle_speed;
     plan_data.condition = (gc_state.modal.spindle | gc_state.modal.coolant);
+    if (gc_block.non_modal_command == NON_MODAL_ABSOLUTE_OVERRIDE) { plan_data.condition |= PL_COND_FLAG_MACHINE_COORD; }
     #ifdef USE_OUTPUT_PWM
       // Add output PWM value to planner data
       pl_data->output_volts = gc_state.output_volts;
     #endif
 
     uint8_t status = jog_execute(&plan_data, &gc_block);
-    if (status == STATUS_OK) { memcpy(gc_state.position, gc_block.values.xyz, sizeof(gc_block.values.xyz)); }
+    if (status == STATUS_OK) {
+      gc_convert_machine_target(&gc_block, pl_data);
+      memcpy(gc_state.position, gc_block.values.xyz, sizeof(gc_block.values.xyz));
+    }
     return(status);
   }
 
@@ -1443,6 +1362,15 @@ uint8_t gc_execute_line(char *line)
       mc_line(gc_block.values.ijk, pl_data);
       memcpy(gc_state.position, gc_block.values.ijk, N_AXIS*sizeof(float));
       break;
+    #ifdef ENABLE_WELL_PLATE_CYCLE
+      case NON_MODAL_PLATE_CYCLE:
+        // Queue the cycle. Its motions are expanded as planner space frees up, while the next lines
+        // are parsed. The target is returned as the final position, retracted above the last well.
+        mc_plate_cycle(gc_block.values.xyz, pl_data, gc_block.values.ijk[AXIS_LETTER_INDEX('X')],
+            gc_block.values.ijk[AXIS_LETTER_INDEX('Y')], gc_block.values.p, gc_block.values.l, gc_block.values.r);
+        memcpy(gc_state.position, gc_block.values.xyz, sizeof(gc_block.values.xyz));
+        break;
+    #endif
     case NON_MODAL_SET_HOME_0:
       settings_write_coord_data(SETTING_INDEX_G28,gc_state.position);
       break;
@@ -1457,6 +1385,29 @@ uint8_t gc_execute_line(char *line)
       clear_vector(gc_state.coord_offset); // Disable G92 offsets by zeroing offset vector.
       system_flag_wco_change();
       break;
+    #ifdef ENABLE_COORD_TRANSFORM
+      case NON_MODAL_SET_TRANSFORM: case NON_MODAL_CANCEL_TRANSFORM:
+        // The queued motions were planned with the prior transform. Then the programmed position is
+        // recomputed from the machine position with the new one.
+        protocol_buffer_synchronize();
+        {
+          float transform_data[N_TRANSFORM_DATA];
+          memset(transform_data, 0, sizeof(transform_data));
+          transform_data[TRANSFORM_SCALE_X] = 1.0;
+          transform_data[TRANSFORM_SCALE_Y] = 1.0;
+          if (gc_block.non_modal_command == NON_MODAL_SET_TRANSFORM) {
+            transform_data[TRANSFORM_CENTER_X] = gc_block.values.xyz[AXIS_LETTER_INDEX('X')];
+            transform_data[TRANSFORM_CENTER_Y] = gc_block.values.xyz[AXIS_LETTER_INDEX('Y')];
+            transform_data[TRANSFORM_ROTATION] = gc_block.values.r;
+            transform_data[TRANSFORM_SCALE_X] = gc_block.values.ijk[AXIS_LETTER_INDEX('X')];
+            transform_data[TRANSFORM_SCALE_Y] = gc_block.values.ijk[AXIS_LETTER_INDEX('Y')];
+            if (AXIS_LETTER_MASK('Z')) { transform_data[TRANSFORM_SKEW] = gc_block.values.ijk[AXIS_LETTER_INDEX('Z')]; }
+          }
+          transform_set(transform_data);
+        }
+        gc_sync_position();
+        break;
+    #endif
   }
 
 
@@ -1467,25 +1418,28 @@ uint8_t gc_execute_line(char *line)
   if (gc_state.modal.motion != MOTION_MODE_NONE) {
     if (axis_command == AXIS_COMMAND_MOTION_MODE) {
       uint8_t gc_update_pos = GC_UPDATE_POS_TARGET;
+      // G53 targets are machine coordinates, which the height map and coordinate transform leave as is.
+      if (gc_block.non_modal_command == NON_MODAL_ABSOLUTE_OVERRIDE) { pl_data->condition |= PL_COND_FLAG_MACHINE_COORD; }
       if (gc_state.modal.motion == MOTION_MODE_LINEAR) {
         mc_line(gc_block.values.xyz, pl_data);
       } else if (gc_state.modal.motion == MOTION_MODE_SEEK) {
         pl_data->condition |= PL_COND_FLAG_RAPID_MOTION; // Set rapid motion condition flag.
         mc_line(gc_block.values.xyz, pl_data);
       } else if ((gc_state.modal.motion == MOTION_MODE_CW_ARC) || (gc_state.modal.motion == MOTION_MODE_CCW_ARC)) {
-        // GBGB TODO : Revoir mc_arc() pour le clonage et le renomage des axes...
         mc_arc(gc_block.values.xyz, pl_data, gc_state.position, gc_block.values.ijk, gc_block.values.r,
-            axis_0, axis_1, axis_linear, axis_0_mask, axis_1_mask, axis_linear_mask,
-            axis_a, axis_b, axis_c, axis_a_mask, axis_b_mask, axis_c_mask,
-            axis_u, axis_v, axis_w, axis_u_mask, axis_v_mask, axis_w_mask,
-            axis_d, axis_e, axis_h, axis_d_mask, axis_e_mask, axis_h_mask,
-            bit_istrue(gc_parser_flags,GC_PARSER_ARC_IS_CLOCKWISE));
+            axis_0, axis_1, axis_0_mask, axis_1_mask, bit_istrue(gc_parser_flags,GC_PARSER_ARC_IS_CLOCKWISE));
       } else {
         // NOTE: gc_block.values.xyz is returned from mc_probe_cycle with the updated position value. So
         // upon a successful probing cycle, the machine position and the returned value should be the same.
         #ifndef ALLOW_FEED_OVERRIDE_DURING_PROBE_CYCLES
           pl_data->condition |= PL_COND_FLAG_NO_FEED_OVERRIDE;
         #endif
+        #ifdef ENABLE_TWO_STAGE_PROBE
+          if (gc_block.values.r > 0.0) {
+            gc_update_pos = mc_probe_cycle_two_stage(gc_block.values.xyz, pl_data, gc_parser_flags,
+                                                     gc_block.values.p, gc_block.values.r);
+          } else
+        #endif
         gc_update_pos = mc_probe_cycle(gc_block.values.xyz, pl_data, gc_parser_flags);
       }
 
@@ -1493,6 +1447,7 @@ uint8_t gc_execute_line(char *line)
       // motion control system might still be processing the action and the real tool position
       // in any intermediate location.
       if (gc_update_pos == GC_UPDATE_POS_TARGET) {
+        gc_convert_machine_target(&gc_block, pl_data);
         memcpy(gc_state.position, gc_block.values.xyz, sizeof(gc_block.values.xyz)); // gc_state.position[] = gc_block.values.xyz[]
       } else if (gc_update_pos == GC_UPDATE_POS_SYSTEM) {
         gc_sync_position(); // gc_state.position[] = sys_position
@@ -1609,8 +1564,6 @@ uint8_t gc_execute_line(char *line)
     }
   #endif
 
-  // TODO: % to denote start of program.
-
   return(STATUS_OK);
 }
 
@@ -1618,11 +1571,10 @@ uint8_t gc_execute_line(char *line)
 /*
   Not supported:
 
-  - Canned cycles
+  - Canned cycles, except the G70 well plate cycle (*)
   - Tool radius compensation
   - A,B,C-axes // A, B & C Supported in Ramps 1.4 grbl-Mega-5X version if N_AXIS > 3
-  - Evaluation of expressions
-  - Variables
+  - Named parameters (numbered parameters and expressions are supported with O-words (*))
   - Override control (TBD)
   - Tool changes
   - Switches
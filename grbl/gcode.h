@@ -69,6 +69,13 @@
 #define NON_MODAL_ABSOLUTE_OVERRIDE 53 // G53 (Do not alter value)
 #define NON_MODAL_SET_COORDINATE_OFFSET 92 // G92 (Do not alter value)
 #define NON_MODAL_RESET_COORDINATE_OFFSET 102 //G92.1 (Do not alter value)
+#ifdef ENABLE_WELL_PLATE_CYCLE
+  #define NON_MODAL_PLATE_CYCLE 70 // G70 (Do not alter value)
+#endif
+#ifdef ENABLE_COORD_TRANSFORM
+  #define NON_MODAL_SET_TRANSFORM 168 // G68 (Clear of M68 in the same variable)
+  #define NON_MODAL_CANCEL_TRANSFORM 169 // G69
+#endif
 
 // Modal Group G1: Motion modes
 #define MOTION_MODE_SEEK 0 // G0 (Default: Must be zero)
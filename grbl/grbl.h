@@ -32,6 +32,7 @@
 #include <avr/interrupt.h>
 #include <avr/wdt.h>
 #include <util/delay.h>
+#include <util/crc16.h>
 #include <math.h>
 #include <inttypes.h>
 #include <string.h>
@@ -64,6 +65,11 @@
 #include "stepper.h"
 #include "jog.h"
 #include "sleep.h"
+#include "tick.h"
+#include "oword.h"
+#include "input_filter.h"
+#include "height_map.h"
+#include "transform.h"
 
 // ---------------------------------------------------------------------------------------
 // COMPILE-TIME ERROR CHECKING OF DEFINE VALUES:
@@ -84,6 +90,12 @@
   #endif
 #endif
 
+#if defined(ENABLE_BINARY_STATUS_REPORT)
+  #if !defined(ENABLE_TX_PRIORITY_BUFFER)
+    #error "ENABLE_BINARY_STATUS_REPORT must be enabled with ENABLE_TX_PRIORITY_BUFFER."
+  #endif
+#endif
+
 #if defined(SPINDLE_PWM_MIN_VALUE)
   #if !(SPINDLE_PWM_MIN_VALUE > 0)
     #error "SPINDLE_PWM_MIN_VALUE must be greater than zero."
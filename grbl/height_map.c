@@ -0,0 +1,140 @@
+/*
+  height_map.c - surface height map compensation of the Z axis
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_HEIGHT_MAP
+
+#ifndef ENABLE_PROBE_RESULT_BUFFER
+  #error "ENABLE_HEIGHT_MAP requires ENABLE_PROBE_RESULT_BUFFER."
+#endif
+#if (HEIGHT_MAP_COLUMNS < 2) || (HEIGHT_MAP_ROWS < 2)
+  #error "HEIGHT_MAP_COLUMNS and HEIGHT_MAP_ROWS must be 2 or more."
+#endif
+#if (HEIGHT_MAP_COLUMNS*HEIGHT_MAP_ROWS) > N_PROBE_RESULT
+  #error "The probe result buffer must hold the HEIGHT_MAP_COLUMNS*HEIGHT_MAP_ROWS grid points."
+#endif
+
+height_map_t height_map;
+
+
+// Returns the grid cell index along one axis, and the position fraction within the cell.
+static uint8_t height_map_locate(float position, uint8_t axis, uint8_t n_point, float *fraction)
+{
+  float u = (position-height_map.origin[axis])/height_map.spacing[axis];
+  if (u < 0.0) { u = 0.0; }
+  else if (u > n_point-1) { u = n_point-1; }
+  uint8_t cell = trunc(u);
+  if (cell > n_point-2) { cell = n_point-2; } // Last grid point is the end of the last cell.
+  *fraction = u-cell;
+  return(cell);
+}
+
+
+float height_map_get_offset(float *position)
+{
+  float u, v;
+  uint8_t col = height_map_locate(position[HEIGHT_MAP_X], 0, HEIGHT_MAP_COLUMNS, &u);
+  uint8_t row = height_map_locate(position[HEIGHT_MAP_Y], 1, HEIGHT_MAP_ROWS, &v);
+  float z0 = height_map.offset[row][col] + u*(height_map.offset[row][col+1]-height_map.offset[row][col]);
+  float z1 = height_map.offset[row+1][col] + u*(height_map.offset[row+1][col+1]-height_map.offset[row+1][col]);
+  return(z0 + v*(z1-z0));
+}
+
+
+void height_map_get_range(float *offset_min, float *offset_max)
+{
+  uint8_t row, col;
+  *offset_min = height_map.offset[0][0];
+  *offset_max = height_map.offset[0][0];
+  for (row=0; row<HEIGHT_MAP_ROWS; row++) {
+    for (col=0; col<HEIGHT_MAP_COLUMNS; col++) {
+      if (height_map.offset[row][col] < *offset_min) { *offset_min = height_map.offset[row][col]; }
+      if (height_map.offset[row][col] > *offset_max) { *offset_max = height_map.offset[row][col]; }
+    }
+  }
+}
+
+
+// Adds the Z offset to all the axes named Z.
+static void height_map_offset_z(float *position, float offset)
+{
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_istrue(AXIS_LETTER_MASK('Z'),bit(idx))) { position[idx] += offset; }
+  }
+}
+
+
+void height_map_apply(float *position) { height_map_offset_z(position, height_map_get_offset(position)); }
+
+
+void height_map_remove(float *position)
+{
+  if (height_map.enabled) { height_map_offset_z(position, -height_map_get_offset(position)); }
+}
+
+
+uint8_t height_map_load_probe_results()
+{
+  if (!(AXIS_LETTER_MASK('X') && AXIS_LETTER_MASK('Y') && AXIS_LETTER_MASK('Z'))) { return(STATUS_HEIGHT_MAP_INVALID); }
+  uint8_t count = probe_get_result_count();
+  if (count < HEIGHT_MAP_COLUMNS*HEIGHT_MAP_ROWS) { return(STATUS_HEIGHT_MAP_INVALID); }
+  uint8_t first = count-HEIGHT_MAP_COLUMNS*HEIGHT_MAP_ROWS;
+
+  // Grid origin and spacing from the first point and its neighbors along X and Y.
+  probe_result_t result;
+  float reference;
+  probe_read_result(first, &result);
+  height_map.origin[0] = result.position[HEIGHT_MAP_X];
+  height_map.origin[1] = result.position[HEIGHT_MAP_Y];
+  reference = result.position[HEIGHT_MAP_Z];
+  probe_read_result(first+1, &result);
+  height_map.spacing[0] = result.position[HEIGHT_MAP_X]-height_map.origin[0];
+  probe_read_result(first+HEIGHT_MAP_COLUMNS, &result);
+  height_map.spacing[1] = result.position[HEIGHT_MAP_Y]-height_map.origin[1];
+  if ((height_map.spacing[0] == 0.0) || (height_map.spacing[1] == 0.0)) {
+    height_map_clear();
+    return(STATUS_HEIGHT_MAP_INVALID);
+  }
+
+  uint8_t row, col;
+  uint8_t index = first;
+  for (row=0; row<HEIGHT_MAP_ROWS; row++) {
+    for (col=0; col<HEIGHT_MAP_COLUMNS; col++) {
+      probe_read_result(index++, &result);
+      // Each point must be a contact within a quarter of the spacing from its grid position.
+      if (!result.succeeded ||
+          (fabs(result.position[HEIGHT_MAP_X]-(height_map.origin[0]+col*height_map.spacing[0])) > 0.25*fabs(height_map.spacing[0])) ||
+          (fabs(result.position[HEIGHT_MAP_Y]-(height_map.origin[1]+row*height_map.spacing[1])) > 0.25*fabs(height_map.spacing[1]))) {
+        height_map_clear();
+        return(STATUS_HEIGHT_MAP_INVALID);
+      }
+      height_map.offset[row][col] = result.position[HEIGHT_MAP_Z]-reference;
+    }
+  }
+  height_map.enabled = true;
+  return(STATUS_OK);
+}
+
+
+void height_map_clear() { height_map.enabled = false; }
+
+#endif
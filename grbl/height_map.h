@@ -0,0 +1,67 @@
+/*
+  height_map.h - surface height map compensation of the Z axis
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef height_map_h
+#define height_map_h
+
+#ifndef HEIGHT_MAP_COLUMNS
+  #define HEIGHT_MAP_COLUMNS 3
+#endif
+#ifndef HEIGHT_MAP_ROWS
+  #define HEIGHT_MAP_ROWS 3
+#endif
+#ifndef HEIGHT_MAP_SEGMENT_LENGTH
+  #define HEIGHT_MAP_SEGMENT_LENGTH 5.0
+#endif
+
+// Axes of the map. Cloned axes follow the first axis of the same name.
+#define HEIGHT_MAP_X AXIS_LETTER_INDEX('X')
+#define HEIGHT_MAP_Y AXIS_LETTER_INDEX('Y')
+#define HEIGHT_MAP_Z AXIS_LETTER_INDEX('Z')
+
+typedef struct {
+  uint8_t enabled;       // Offsets are applied to the motions.
+  float origin[2];       // XY machine position of the first grid point.
+  float spacing[2];      // Signed XY distance between the grid points.
+  float offset[HEIGHT_MAP_ROWS][HEIGHT_MAP_COLUMNS]; // Z offset of each grid point, row along X.
+} height_map_t;
+extern height_map_t height_map;
+
+// Returns the Z offset at the XY of the position, interpolated between the four nearest grid points.
+// Positions outside of the grid take the offset of the nearest grid edge.
+float height_map_get_offset(float *position);
+
+// Returns the lowest and highest Z offsets of the grid, which bound all the interpolated offsets.
+void height_map_get_range(float *offset_min, float *offset_max);
+
+// Adds the Z offset at the XY of the position to its Z axes.
+void height_map_apply(float *position);
+
+// Converts a machine position to the programmed position, by removing the Z offset, if enabled.
+void height_map_remove(float *position);
+
+// Builds the map from the last probe results, probed row by row from the first grid point, and
+// enables it. Offsets are relative to the first grid point.
+uint8_t height_map_load_probe_results();
+
+// Disables the map.
+void height_map_clear();
+
+#endif
@@ -0,0 +1,162 @@
+/*
+  input_filter.c - digital filtering of the limit, probe, control and digital input pins
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_INPUT_FILTER
+
+#if (INPUT_FILTER_LIMITS == INPUT_FILTER_MAJORITY) && (INPUT_FILTER_LIMITS_SAMPLES > 8)
+  #error "INPUT_FILTER_LIMITS_SAMPLES must be 8 or less with INPUT_FILTER_MAJORITY."
+#endif
+#if (INPUT_FILTER_PROBE == INPUT_FILTER_MAJORITY) && (INPUT_FILTER_PROBE_SAMPLES > 8)
+  #error "INPUT_FILTER_PROBE_SAMPLES must be 8 or less with INPUT_FILTER_MAJORITY."
+#endif
+#if (INPUT_FILTER_CONTROL == INPUT_FILTER_MAJORITY) && (INPUT_FILTER_CONTROL_SAMPLES > 8)
+  #error "INPUT_FILTER_CONTROL_SAMPLES must be 8 or less with INPUT_FILTER_MAJORITY."
+#endif
+#if (INPUT_FILTER_DIGITAL == INPUT_FILTER_MAJORITY) && (INPUT_FILTER_DIGITAL_SAMPLES > 8)
+  #error "INPUT_FILTER_DIGITAL_SAMPLES must be 8 or less with INPUT_FILTER_MAJORITY."
+#endif
+
+#define N_CONTROL_INPUT 4 // Bits of the CONTROL_PIN_INDEX bitfield
+#define N_DIGITAL_INPUT 8 // The DIGITAL_INPUT_STATE bits are the upper half of the digital state.
+
+volatile uint8_t input_filter_limits;
+volatile uint8_t input_filter_probe;
+volatile uint8_t input_filter_control;
+volatile uint8_t input_filter_digital;
+
+// Integrator count, or last samples of the majority filter, of each input.
+#ifdef INPUT_FILTERED_LIMITS
+  static uint8_t limits_history[N_AXIS];
+#endif
+#ifdef INPUT_FILTERED_PROBE
+  static uint8_t probe_history[1];
+#endif
+#ifdef INPUT_FILTERED_CONTROL
+  static uint8_t control_history[N_CONTROL_INPUT];
+#endif
+#ifdef INPUT_FILTERED_DIGITAL
+  static uint8_t digital_history[N_DIGITAL_INPUT];
+#endif
+
+
+// Sets the filter of each input bit of a group as settled on the sampled state.
+static void input_filter_reset(uint8_t *history, uint8_t sample, uint8_t n_input, uint8_t type, uint8_t n_sample)
+{
+  uint8_t idx;
+  for (idx=0; idx<n_input; idx++) {
+    if (sample & bit(idx)) {
+      history[idx] = (type == INPUT_FILTER_MAJORITY) ? 0xff : n_sample;
+    } else {
+      history[idx] = 0;
+    }
+  }
+}
+
+
+// Filters a new sample of each input bit of a group. Returns the new filtered state of the group.
+static uint8_t input_filter_sample(uint8_t *history, uint8_t state, uint8_t sample, uint8_t n_input, uint8_t type, uint8_t n_sample)
+{
+  uint8_t idx;
+  for (idx=0; idx<n_input; idx++) {
+    uint8_t mask = bit(idx);
+    if (type == INPUT_FILTER_MAJORITY) {
+      uint8_t samples = (history[idx] << 1) | ((sample & mask) ? 1 : 0);
+      history[idx] = samples;
+      uint8_t count = 0;
+      uint8_t n;
+      for (n=0; n<n_sample; n++) {
+        count += (samples & 1);
+        samples >>= 1;
+      }
+      if (2*count > n_sample) { state |= mask; } else { state &= ~mask; }
+    } else { // INPUT_FILTER_INTEGRATOR
+      if (sample & mask) {
+        if (history[idx] < n_sample) { history[idx]++; }
+        if (history[idx] == n_sample) { state |= mask; }
+      } else {
+        if (history[idx]) { history[idx]--; }
+        if (history[idx] == 0) { state &= ~mask; }
+      }
+    }
+  }
+  return(state);
+}
+
+
+void input_filter_init()
+{
+  uint8_t sreg = SREG;
+  cli(); // The tick may already be running upon a soft-reset.
+  #ifdef INPUT_FILTERED_LIMITS
+    input_filter_limits = limits_get_state();
+    input_filter_reset(limits_history, input_filter_limits, N_AXIS, INPUT_FILTER_LIMITS, INPUT_FILTER_LIMITS_SAMPLES);
+  #endif
+  #ifdef INPUT_FILTERED_PROBE
+    input_filter_probe = (PROBE_PIN & PROBE_MASK);
+    input_filter_reset(probe_history, (input_filter_probe ? 1 : 0), 1, INPUT_FILTER_PROBE, INPUT_FILTER_PROBE_SAMPLES);
+  #endif
+  #ifdef INPUT_FILTERED_CONTROL
+    input_filter_control = system_control_get_pin_state();
+    input_filter_reset(control_history, input_filter_control, N_CONTROL_INPUT, INPUT_FILTER_CONTROL, INPUT_FILTER_CONTROL_SAMPLES);
+  #endif
+  #ifdef INPUT_FILTERED_DIGITAL
+    input_filter_digital = digital_get_input_pin_state();
+    input_filter_reset(digital_history, input_filter_digital, N_DIGITAL_INPUT, INPUT_FILTER_DIGITAL, INPUT_FILTER_DIGITAL_SAMPLES);
+  #endif
+  SREG = sreg;
+}
+
+
+// NOTE: Runs in the tick interrupt. Limits and control pins act only when they become triggered,
+// like with the pin change interrupts.
+void input_filter_update()
+{
+  #ifdef INPUT_FILTERED_LIMITS
+    uint8_t limits_state = input_filter_sample(limits_history, input_filter_limits, limits_get_state(),
+                                               N_AXIS, INPUT_FILTER_LIMITS, INPUT_FILTER_LIMITS_SAMPLES);
+    #ifdef ENABLE_RAMPS_HW_LIMITS
+      if (limits_state && !input_filter_limits) { ramps_hard_limit(); }
+    #endif
+    input_filter_limits = limits_state;
+  #endif
+
+  #ifdef INPUT_FILTERED_PROBE
+    uint8_t probe_state = input_filter_sample(probe_history, (input_filter_probe ? 1 : 0), ((PROBE_PIN & PROBE_MASK) ? 1 : 0),
+                                              1, INPUT_FILTER_PROBE, INPUT_FILTER_PROBE_SAMPLES);
+    input_filter_probe = (probe_state ? PROBE_MASK : 0);
+  #endif
+
+  #ifdef INPUT_FILTERED_CONTROL
+    uint8_t control_state = input_filter_sample(control_history, input_filter_control, system_control_get_pin_state(),
+                                                N_CONTROL_INPUT, INPUT_FILTER_CONTROL, INPUT_FILTER_CONTROL_SAMPLES);
+    uint8_t control_triggered = control_state & ~input_filter_control;
+    input_filter_control = control_state;
+    if (control_triggered) { system_execute_control(control_triggered); }
+  #endif
+
+  #ifdef INPUT_FILTERED_DIGITAL
+    input_filter_digital = input_filter_sample(digital_history, input_filter_digital, digital_get_input_pin_state(),
+                                               N_DIGITAL_INPUT, INPUT_FILTER_DIGITAL, INPUT_FILTER_DIGITAL_SAMPLES);
+  #endif
+}
+
+#endif
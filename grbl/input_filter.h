@@ -0,0 +1,83 @@
+/*
+  input_filter.h - digital filtering of the limit, probe, control and digital input pins
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef input_filter_h
+#define input_filter_h
+
+// Define input filter types.
+#define INPUT_FILTER_NONE        0 // Pins are read directly, as without filtering.
+#define INPUT_FILTER_MAJORITY    1 // State of most of the last samples. Up to 8 samples.
+#define INPUT_FILTER_INTEGRATOR  2 // Counts samples up while triggered and down while not. Switches at either end.
+
+#ifndef INPUT_FILTER_LIMITS
+  #define INPUT_FILTER_LIMITS INPUT_FILTER_INTEGRATOR
+#endif
+#ifndef INPUT_FILTER_LIMITS_SAMPLES
+  #define INPUT_FILTER_LIMITS_SAMPLES 3
+#endif
+#ifndef INPUT_FILTER_PROBE
+  #define INPUT_FILTER_PROBE INPUT_FILTER_MAJORITY
+#endif
+#ifndef INPUT_FILTER_PROBE_SAMPLES
+  #define INPUT_FILTER_PROBE_SAMPLES 5
+#endif
+#ifndef INPUT_FILTER_CONTROL
+  #define INPUT_FILTER_CONTROL INPUT_FILTER_INTEGRATOR
+#endif
+#ifndef INPUT_FILTER_CONTROL_SAMPLES
+  #define INPUT_FILTER_CONTROL_SAMPLES 3
+#endif
+#ifndef INPUT_FILTER_DIGITAL
+  #define INPUT_FILTER_DIGITAL INPUT_FILTER_INTEGRATOR
+#endif
+#ifndef INPUT_FILTER_DIGITAL_SAMPLES
+  #define INPUT_FILTER_DIGITAL_SAMPLES 3
+#endif
+
+// Define which input groups are sampled and filtered by the tick.
+#ifdef ENABLE_INPUT_FILTER
+  #if INPUT_FILTER_LIMITS != INPUT_FILTER_NONE
+    #define INPUT_FILTERED_LIMITS
+  #endif
+  #if INPUT_FILTER_PROBE != INPUT_FILTER_NONE
+    #define INPUT_FILTERED_PROBE
+  #endif
+  #if INPUT_FILTER_CONTROL != INPUT_FILTER_NONE
+    #define INPUT_FILTERED_CONTROL
+  #endif
+  #if defined(USE_DIGITAL_INPUT) && (INPUT_FILTER_DIGITAL != INPUT_FILTER_NONE)
+    #define INPUT_FILTERED_DIGITAL
+  #endif
+#endif
+
+// Filtered input states, with the bit layout of the unfiltered ones. Updated by the tick.
+extern volatile uint8_t input_filter_limits;  // As limits_get_state()
+extern volatile uint8_t input_filter_probe;   // Probe pin level, as (PROBE_PIN & PROBE_MASK)
+extern volatile uint8_t input_filter_control; // As system_control_get_pin_state()
+extern volatile uint8_t input_filter_digital; // As digital_get_input_pin_state()
+
+// Initializes the filters with the current pin states. Called upon every reset.
+void input_filter_init();
+
+// Samples and filters the input pins, then acts on the newly triggered limits and control pins.
+// Called by the millisecond tick.
+void input_filter_update();
+
+#endif
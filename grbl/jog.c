@@ -28,11 +28,14 @@ uint8_t jog_execute(plan_line_data_t *pl_data, parser_block_t *gc_block)
   // Initialize planner data struct for jogging motions.
   // NOTE: Spindle and coolant are allowed to fully function with overrides during a jog.
   pl_data->feed_rate = gc_block->values.f;
-  pl_data->condition |= PL_COND_FLAG_NO_FEED_OVERRIDE;
+  pl_data->condition |= (PL_COND_FLAG_NO_FEED_OVERRIDE|PL_COND_FLAG_JOG);
   pl_data->line_number = gc_block->values.n;
 
   if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) {
-    if (system_check_travel_limits(gc_block->values.xyz)) { return(STATUS_TRAVEL_EXCEEDED); }
+    float machine_target[N_AXIS];
+    memcpy(machine_target, gc_block->values.xyz, sizeof(machine_target));
+    mc_convert_to_machine_position(machine_target, pl_data->condition); // Check the compensated target.
+    if (system_check_travel_limits(machine_target)) { return(STATUS_TRAVEL_EXCEEDED); }
   }
 
   // Valid jog command. Plan, set state, and execute.
@@ -109,6 +109,10 @@ void limits_init()
       MAX_LIMIT_PORT(5) |= (1<<MAX_LIMIT_BIT(5));  // Enable internal pull-up resistors. Normal high operation.
     #endif
   #endif
+
+  #ifdef ENABLE_RAMPS_HW_LIMITS
+    ramps_hard_limit_init();
+  #endif
 }
 
 #if N_AXIS == 4
@@ -172,6 +176,70 @@ uint8_t limits_get_state()
 }
 
 #ifdef ENABLE_RAMPS_HW_LIMITS
+  // Limit pins grouped by port, with the pin levels of untriggered switches, so a poll is one compare
+  // per port instead of the per-pin loop of limits_get_state(). Built upon init from the pin tables.
+  static volatile uint8_t *ramps_limit_pin[2*N_AXIS];
+  static uint8_t ramps_limit_mask[2*N_AXIS];
+  static uint8_t ramps_limit_idle[2*N_AXIS];
+  static uint8_t ramps_limit_n_port;
+  static uint8_t ramps_limit_debounce; // Consecutive polls with a triggered limit pin.
+
+  static void ramps_limit_add_pin(volatile uint8_t *pin, uint8_t bit_mask, uint8_t inverted)
+  {
+    uint8_t idx;
+    for (idx=0; idx<ramps_limit_n_port; idx++) {
+      if (ramps_limit_pin[idx] == pin) { break; }
+    }
+    if (idx == ramps_limit_n_port) {
+      ramps_limit_pin[idx] = pin;
+      ramps_limit_mask[idx] = 0;
+      ramps_limit_idle[idx] = 0;
+      ramps_limit_n_port++;
+    }
+    if (!inverted) { ramps_limit_idle[idx] |= bit_mask; } // Switches pull pins low when triggered.
+    ramps_limit_mask[idx] |= bit_mask;
+  }
+
+
+  // NOTE: The pins never change, so the groups are built once, before the tick starts polling them.
+  void ramps_hard_limit_init()
+  {
+    if (ramps_limit_n_port) { return; }
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      #ifdef INVERT_MAX_LIMIT_PIN_MASK
+        ramps_limit_add_pin(max_limit_pins[idx], 1<<max_limit_bits[idx], bit_istrue(INVERT_MAX_LIMIT_PIN_MASK, bit(idx)));
+      #else
+        ramps_limit_add_pin(max_limit_pins[idx], 1<<max_limit_bits[idx], false);
+      #endif
+      #ifdef INVERT_MIN_LIMIT_PIN_MASK
+        ramps_limit_add_pin(min_limit_pins[idx], 1<<min_limit_bits[idx], bit_istrue(INVERT_MIN_LIMIT_PIN_MASK, bit(idx)));
+      #else
+        ramps_limit_add_pin(min_limit_pins[idx], 1<<min_limit_bits[idx], false);
+      #endif
+    }
+  }
+
+
+  // Polled by the millisecond tick, off the stepper interrupt. A limit pin must read triggered for
+  // RAMPS_HW_LIMITS_DEBOUNCE consecutive polls to trip the hard limit. It trips once per trigger, like
+  // the pin change interrupt, so the machine can be unlocked and moved off a triggered switch.
+  void ramps_hard_limit_poll()
+  {
+    uint8_t invert = (bit_istrue(settings.flags,BITFLAG_INVERT_LIMIT_PINS) ? 0xff : 0);
+    uint8_t idx;
+    for (idx=0; idx<ramps_limit_n_port; idx++) {
+      if ((*ramps_limit_pin[idx] ^ ramps_limit_idle[idx] ^ invert) & ramps_limit_mask[idx]) {
+        if (ramps_limit_debounce < RAMPS_HW_LIMITS_DEBOUNCE) {
+          if (++ramps_limit_debounce == RAMPS_HW_LIMITS_DEBOUNCE) { ramps_hard_limit(); }
+        }
+        return;
+      }
+    }
+    ramps_limit_debounce = 0;
+  }
+
+
   void ramps_hard_limit()
   {
     if (bit_istrue(settings.flags,BITFLAG_HARD_LIMIT_ENABLE)) {
@@ -419,26 +487,29 @@ void limits_go_home(uint8_t cycle_mask)
 }
 
 
-// Performs a soft limit check. Called from mc_line() only. Assumes the machine has been homed,
-// the workspace volume is in all negative space, and the system is in normal operation.
+// Performs a soft limit check. Called from mc_line() and mc_arc() only. Assumes the machine has been
+// homed, the workspace volume is in all negative space, and the system is in normal operation.
 // NOTE: Used by jogging to limit travel within soft-limit volume.
 void limits_soft_check(float *target)
 {
-  if (system_check_travel_limits(target)) {
-    sys.soft_limit = true;
-    // Force feed hold if cycle is active. All buffered blocks are guaranteed to be within
-    // workspace volume so just come to a controlled stop so position is not lost. When complete
-    // enter alarm mode.
-    if (sys.state == STATE_CYCLE) {
-      system_set_exec_state_flag(EXEC_FEED_HOLD);
-      do {
-        protocol_execute_realtime();
-        if (sys.abort) { return; }
-      } while ( sys.state != STATE_IDLE );
-    }
-    mc_reset(); // Issue system reset and ensure spindle and coolant are shutdown.
-    system_set_exec_alarm(EXEC_ALARM_SOFT_LIMIT); // Indicate soft limit critical event
-    protocol_execute_realtime(); // Execute to enter critical event loop and system abort
-    return;
+  if (system_check_travel_limits(target)) { limits_soft_alarm(); }
+}
+
+
+void limits_soft_alarm()
+{
+  sys.soft_limit = true;
+  // Force feed hold if cycle is active. All buffered blocks are guaranteed to be within
+  // workspace volume so just come to a controlled stop so position is not lost. When complete
+  // enter alarm mode.
+  if (sys.state == STATE_CYCLE) {
+    system_set_exec_state_flag(EXEC_FEED_HOLD);
+    do {
+      protocol_execute_realtime();
+      if (sys.abort) { return; }
+    } while ( sys.state != STATE_IDLE );
   }
+  mc_reset(); // Issue system reset and ensure spindle and coolant are shutdown.
+  system_set_exec_alarm(EXEC_ALARM_SOFT_LIMIT); // Indicate soft limit critical event
+  protocol_execute_realtime(); // Execute to enter critical event loop and system abort
 }
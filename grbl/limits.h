@@ -36,8 +36,16 @@ void limits_go_home(uint8_t cycle_mask);
 // Check for soft limit violations
 void limits_soft_check(float *target);
 
+// Stops the machine and alarms on a soft limit violation, found by the caller.
+void limits_soft_alarm();
+
 // Hard limit error for RAMPS non interrupt hardware limits
 #ifdef ENABLE_RAMPS_HW_LIMITS
+  #ifndef RAMPS_HW_LIMITS_DEBOUNCE
+    #define RAMPS_HW_LIMITS_DEBOUNCE 2 // Consecutive millisecond polls of a triggered limit pin (1-255)
+  #endif
+  void ramps_hard_limit_init();
+  void ramps_hard_limit_poll();
   void ramps_hard_limit();
 #endif
 #endif
@@ -22,6 +22,67 @@
 
 #include "grbl.h"
 
+// Motion generators queue the motions of a single g-code block in steps, as the planner buffer frees
+// up, instead of blocking the parser until the last motion is queued.
+#define MC_GENERATOR_NONE  0 // Must be zero.
+#define MC_GENERATOR_ARC   1
+#define MC_GENERATOR_PLATE 2
+
+// Well plate cycle steps of each well. Rise and approach apply to the first well only.
+#define PLATE_RISE     0
+#define PLATE_MOVE     1
+#define PLATE_APPROACH 2
+#define PLATE_FEED     3
+#define PLATE_RETRACT  4
+
+typedef struct {
+  uint8_t type;             // Active motion generator. MC_GENERATOR_NONE when idle.
+  uint8_t step;             // Next motion step of the generator. Arc segments since the last correction.
+  plan_line_data_t pl_data; // Planner data of the generating block.
+  float position[N_AXIS];   // Target of the last queued motion.
+  union {
+    struct {
+      float target[N_AXIS];
+      float linear_per_segment[N_AXIS];
+      float center_axis0;   // Circle center in the arc plane.
+      float center_axis1;
+      float offset_axis0;   // Offset from the arc start to the circle center.
+      float offset_axis1;
+      float r_axis0;        // Radius vector from the circle center to the last segment end.
+      float r_axis1;
+      float theta_per_segment;
+      float radius;
+      float sin_T;
+      float cos_T;
+      uint16_t segment;     // Next segment.
+      uint16_t segments;
+      uint8_t axis_0_mask;
+      uint8_t axis_1_mask;
+    } arc;
+    #ifdef ENABLE_WELL_PLATE_CYCLE
+      struct {
+        float origin[N_AXIS]; // First well at depth.
+        float column_pitch;   // Well pitch along X and Y.
+        float row_pitch;
+        float rise;           // Retract height above the well depth.
+        uint8_t columns;
+        uint16_t well;        // Current well, in serpentine order.
+        uint16_t n_well;
+      } plate;
+    #endif
+  };
+} mc_generator_t;
+static mc_generator_t mc_gen;
+
+static void mc_plan_line(float *target, plan_line_data_t *pl_data);
+static void mc_queue_line(float *target, plan_line_data_t *pl_data);
+
+
+void mc_init()
+{
+  mc_gen.type = MC_GENERATOR_NONE;
+}
+
 
 // Execute linear motion in absolute millimeter coordinates. Feed rate given in millimeters/second
 // unless invert_feed_rate is true. Then the feed_rate means that the motion should be completed in
@@ -33,15 +94,141 @@
 void mc_line(float *target, plan_line_data_t *pl_data)
 {
   // If enabled, check for soft limit violations. Placed here all line motions are picked up
-  // from everywhere in Grbl.
+  // from everywhere in Grbl. The target is checked in machine coordinates, once compensated.
   if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) {
     // NOTE: Block jog state. Jogging is a special case and soft limits are handled independently.
-    if (sys.state != STATE_JOG) { limits_soft_check(target); }
+    if (sys.state != STATE_JOG) {
+      float machine_target[N_AXIS];
+      memcpy(machine_target, target, sizeof(machine_target));
+      mc_convert_to_machine_position(machine_target, pl_data->condition);
+      limits_soft_check(machine_target);
+    }
   }
+  mc_generator_finish(); // Queue the motions still pending from a prior block first.
+  mc_plan_line(target, pl_data);
+}
+
 
+// Converts a programmed position to machine coordinates, by applying the G68 coordinate transform, then
+// the height map Z offset. G53 machine coordinate motions, flagged in condition, are left as is.
+void mc_convert_to_machine_position(float *position, uint16_t condition)
+{
+  if (bit_istrue(condition,PL_COND_FLAG_MACHINE_COORD)) { return; }
+  #ifdef ENABLE_COORD_TRANSFORM
+    transform_apply(position);
+  #endif
+  #ifdef ENABLE_HEIGHT_MAP
+    if (height_map.enabled) { height_map_apply(position); }
+  #endif
+}
+
+
+// Returns true if any programmed position within the box exceeds the machine travel, once compensated.
+// The transform maps the box to a parallelogram, which lies within its transformed XY corners. The Z
+// span is widened by the height map offsets, which interpolate between the grid offsets.
+uint8_t mc_check_travel_limits_box(float *box_min, float *box_max)
+{
+  float corner[N_AXIS];
+  uint8_t corner_idx, idx;
+  for (corner_idx=0; corner_idx<8; corner_idx++) {
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (bit_istrue(AXIS_LETTER_MASK('X'),bit(idx))) { corner[idx] = (corner_idx & bit(0)) ? box_max[idx] : box_min[idx]; }
+      else if (bit_istrue(AXIS_LETTER_MASK('Y'),bit(idx))) { corner[idx] = (corner_idx & bit(1)) ? box_max[idx] : box_min[idx]; }
+      else { corner[idx] = (corner_idx & bit(2)) ? box_max[idx] : box_min[idx]; }
+    }
+    #ifdef ENABLE_COORD_TRANSFORM
+      transform_apply(corner);
+    #endif
+    #ifdef ENABLE_HEIGHT_MAP
+      if (height_map.enabled) {
+        float offset_min, offset_max;
+        height_map_get_range(&offset_min, &offset_max);
+        for (idx=0; idx<N_AXIS; idx++) {
+          if (bit_istrue(AXIS_LETTER_MASK('Z'),bit(idx))) { corner[idx] += (corner_idx & bit(2)) ? offset_max : offset_min; }
+        }
+      }
+    #endif
+    if (system_check_travel_limits(corner)) { return(true); }
+  }
+  return(false);
+}
+
+
+// Converts a machine position to the programmed position, by removing the height map Z offset, then the
+// G68 coordinate transform.
+void mc_convert_to_program_position(float *position)
+{
+  #ifdef ENABLE_HEIGHT_MAP
+    height_map_remove(position);
+  #endif
+  #ifdef ENABLE_COORD_TRANSFORM
+    transform_remove(position);
+  #endif
+}
+
+
+// Queues a line motion in the planner, as mc_line() without the soft limit check. Used by the motion
+// generators, which check the soft limits of the whole arc or cycle up front.
+static void mc_plan_line(float *target, plan_line_data_t *pl_data)
+{
   // If in check gcode mode, prevent motion by blocking planner. Soft limits still work.
   if (sys.state == STATE_CHECK_MODE) { return; }
 
+  #ifdef ENABLE_COORD_TRANSFORM
+    // Motions are programmed in the G68 transformed plane. Queue them in machine coordinates. G53
+    // targets already are.
+    float machine_target[N_AXIS];
+    if (bit_isfalse(pl_data->condition,PL_COND_FLAG_MACHINE_COORD)) {
+      memcpy(machine_target, target, sizeof(machine_target));
+      transform_apply(machine_target);
+      target = machine_target;
+    }
+  #endif
+
+  #ifdef ENABLE_HEIGHT_MAP
+    if (height_map.enabled && bit_isfalse(pl_data->condition,PL_COND_FLAG_MACHINE_COORD)) {
+      // Split the motion in segments no longer than HEIGHT_MAP_SEGMENT_LENGTH in XY, so the Z offset
+      // follows the surface between the grid points. The start is the planner position without its
+      // Z offset. A jog is only compensated at its target. It stays a single block, so that it is
+      // started in the jog state and a jog cancel flushes all of it.
+      float start[N_AXIS];
+      float segment_target[N_AXIS];
+      plan_get_planner_mpos(start);
+      height_map_remove(start);
+      uint16_t segments = 1;
+      if (bit_isfalse(pl_data->condition,PL_COND_FLAG_JOG)) {
+        float distance = hypot_f(target[HEIGHT_MAP_X]-start[HEIGHT_MAP_X], target[HEIGHT_MAP_Y]-start[HEIGHT_MAP_Y]);
+        segments = ceil(distance/HEIGHT_MAP_SEGMENT_LENGTH);
+        if (segments == 0) { segments = 1; }
+      }
+
+      plan_line_data_t segment_data;
+      memcpy(&segment_data, pl_data, sizeof(plan_line_data_t));
+      // Inverse time feed rates apply to the whole motion. Each segment takes its share of the time.
+      if (segment_data.condition & PL_COND_FLAG_INVERSE_TIME) { segment_data.feed_rate *= segments; }
+
+      uint16_t segment;
+      uint8_t idx;
+      for (segment=1; segment<=segments; segment++) {
+        if (segment == segments) { memcpy(segment_target, target, sizeof(segment_target)); }
+        else {
+          float fraction = (float)segment/segments;
+          for (idx=0; idx<N_AXIS; idx++) { segment_target[idx] = start[idx] + fraction*(target[idx]-start[idx]); }
+        }
+        height_map_apply(segment_target);
+        mc_queue_line(segment_target, &segment_data);
+        if (sys.abort) { return; }
+      }
+      return;
+    }
+  #endif
+  mc_queue_line(target, pl_data);
+}
+
+
+// Waits for room in the planner buffer and queues a line motion in machine coordinates.
+static void mc_queue_line(float *target, plan_line_data_t *pl_data)
+{
   // NOTE: Backlash compensation may be installed here. It will need direction info to track when
   // to insert a backlash line motion(s) before the intended line motion and will require its own
   // plan_check_full_buffer() and check for system abort loop. Also for position reporting
@@ -79,18 +266,16 @@ void mc_line(float *target, plan_line_data_t *pl_data)
 
 
 // Execute an arc in offset mode format. position == current xyz, target == target xyz,
-// offset == offset from current xyz, axis_X defines circle plane in tool space, axis_linear is
-// the direction of helical travel, radius == circle radius, isclockwise boolean. Used
-// for vector transformation direction.
+// offset == offset from current xyz, axis_X defines circle plane in tool space, axis_X_mask
+// includes its clones, radius == circle radius, isclockwise boolean. Used for vector
+// transformation direction. All other axes move linearly, which includes helical travel.
 // The arc is approximated by generating a huge number of tiny, linear segments. The chordal tolerance
 // of each segment is configured in settings.arc_tolerance, which is defined to be the maximum normal
 // distance from segment to the circle when the end points both lie on the circle.
+// NOTE: The segments are queued by the motion generator, as the planner buffer frees up. So the arc
+// block returns right away, and the next block is parsed while the arc is still being expanded.
 void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
-  uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t axis_0_mask, uint8_t axis_1_mask, uint8_t axis_linear_mask,
-  uint8_t axis_a, uint8_t axis_b, uint8_t axis_c, uint8_t axis_a_mask, uint8_t axis_b_mask, uint8_t axis_c_mask,
-  uint8_t axis_u, uint8_t axis_v, uint8_t axis_w, uint8_t axis_u_mask, uint8_t axis_v_mask, uint8_t axis_w_mask,
-  uint8_t axis_d, uint8_t axis_e, uint8_t axis_h, uint8_t axis_d_mask, uint8_t axis_e_mask, uint8_t axis_h_mask,
-  uint8_t is_clockwise_arc)
+  uint8_t axis_0, uint8_t axis_1, uint8_t axis_0_mask, uint8_t axis_1_mask, uint8_t is_clockwise_arc)
 {
   float center_axis0 = position[axis_0] + offset[axis_0];
   float center_axis1 = position[axis_1] + offset[axis_1];
@@ -98,9 +283,7 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
   float r_axis1 = -offset[axis_1];
   float rt_axis0 = target[axis_0] - center_axis0;
   float rt_axis1 = target[axis_1] - center_axis1;
-  float a_per_segment, b_per_segment, c_per_segment;
-  float u_per_segment, v_per_segment, w_per_segment;
-  float d_per_segment, e_per_segment, h_per_segment;
+  uint8_t idx;
 
   // CCW angle between position and target from circle center. Only one atan2() trig computation required.
   float angular_travel = atan2(r_axis0*rt_axis1-r_axis1*rt_axis0, r_axis0*rt_axis0+r_axis1*rt_axis1);
@@ -110,6 +293,47 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
     if (angular_travel <= ARC_ANGULAR_TRAVEL_EPSILON) { angular_travel += 2*M_PI; }
   }
 
+  // If enabled, check the soft limits once for the whole arc, instead of for every segment. The
+  // axis-aligned bounding box of the arc spans the start and target positions, and the circle
+  // extremes at each quarter turn the arc travels through. The box is checked once compensated, see
+  // mc_check_travel_limits_box(). A violation alarms before any arc motion.
+  if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) {
+    float box_min[N_AXIS];
+    float box_max[N_AXIS];
+    for (idx=0; idx<N_AXIS; idx++) {
+      box_min[idx] = min(position[idx],target[idx]);
+      box_max[idx] = max(position[idx],target[idx]);
+    }
+    // Angular travel from the start to each quarter turn, counted in the arc direction. The quarter
+    // turns are, in order, the circle extremes at +axis_0, +axis_1, -axis_0 and -axis_1.
+    float quarter_travel = -atan2(r_axis1,r_axis0);
+    uint8_t quarter;
+    for (quarter=0; quarter<4; quarter++) {
+      if (angular_travel < 0) {
+        while (quarter_travel > 0) { quarter_travel -= 2*M_PI; }
+        while (quarter_travel <= -2*M_PI) { quarter_travel += 2*M_PI; }
+      } else {
+        while (quarter_travel < 0) { quarter_travel += 2*M_PI; }
+        while (quarter_travel >= 2*M_PI) { quarter_travel -= 2*M_PI; }
+      }
+      if (fabs(quarter_travel) <= fabs(angular_travel)) {
+        for (idx=0; idx<N_AXIS; idx++) {
+          switch (quarter) {
+            case 0: if (bit_istrue(axis_0_mask,bit(idx))) { box_max[idx] = max(box_max[idx],center_axis0+radius); } break;
+            case 1: if (bit_istrue(axis_1_mask,bit(idx))) { box_max[idx] = max(box_max[idx],center_axis1+radius); } break;
+            case 2: if (bit_istrue(axis_0_mask,bit(idx))) { box_min[idx] = min(box_min[idx],center_axis0-radius); } break;
+            default: if (bit_istrue(axis_1_mask,bit(idx))) { box_min[idx] = min(box_min[idx],center_axis1-radius); }
+          }
+        }
+      }
+      quarter_travel += 0.5*M_PI;
+    }
+    if (mc_check_travel_limits_box(box_min, box_max)) {
+      limits_soft_alarm();
+      if (sys.abort) { return; }
+    }
+  }
+
   // NOTE: Segment end points are on the arc, which can lead to the arc diameter being smaller by up to
   // (2x) settings.arc_tolerance. For 99% of users, this is just fine. If a different arc segment fit
   // is desired, i.e. least-squares, midpoint on arc, just change the mm_per_arc_segment calculation.
@@ -126,17 +350,11 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
       bit_false(pl_data->condition,PL_COND_FLAG_INVERSE_TIME); // Force as feed absolute mode over arc segments.
     }
 
-    float theta_per_segment = angular_travel/segments;
-    float linear_per_segment = (target[axis_linear] - position[axis_linear])/segments;
-    if ( axis_a_mask ) a_per_segment = (target[axis_a] - position[axis_a])/segments; else a_per_segment = 0;
-    if ( axis_b_mask ) b_per_segment = (target[axis_b] - position[axis_b])/segments; else b_per_segment = 0;
-    if ( axis_c_mask ) c_per_segment = (target[axis_c] - position[axis_c])/segments; else c_per_segment = 0;
-    if ( axis_u_mask ) u_per_segment = (target[axis_u] - position[axis_u])/segments; else u_per_segment = 0;
-    if ( axis_v_mask ) v_per_segment = (target[axis_v] - position[axis_v])/segments; else v_per_segment = 0;
-    if ( axis_w_mask ) w_per_segment = (target[axis_w] - position[axis_w])/segments; else w_per_segment = 0;
-    if ( axis_d_mask ) d_per_segment = (target[axis_d] - position[axis_d])/segments; else d_per_segment = 0;
-    if ( axis_e_mask ) e_per_segment = (target[axis_e] - position[axis_e])/segments; else e_per_segment = 0;
-    if ( axis_h_mask ) h_per_segment = (target[axis_h] - position[axis_h])/segments; else h_per_segment = 0;
+    mc_gen.arc.theta_per_segment = angular_travel/segments;
+    // All the axes outside the plane, helical and cloned ones alike, move linearly with the arc.
+    for (idx=0; idx<N_AXIS; idx++) {
+      mc_gen.arc.linear_per_segment[idx] = (target[idx] - position[idx])/segments;
+    }
 
     /* Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
        and phi is the angle of rotation. Solution approach by Jens Geisler.
@@ -164,222 +382,183 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
        This is important when there are successive arc motions.
     */
     // Computes: cos_T = 1 - theta_per_segment^2/2, sin_T = theta_per_segment - theta_per_segment^3/6) in ~52usec
-    float cos_T = 2.0 - theta_per_segment*theta_per_segment;
-    float sin_T = theta_per_segment*0.16666667*(cos_T + 4.0);
-    cos_T *= 0.5;
-
-    float sin_Ti;
-    float cos_Ti;
-    float r_axisi;
-    uint16_t i;
-    uint8_t count = 0;
-
-    for (i = 1; i<segments; i++) { // Increment (segments-1).
-
-      if (count < N_ARC_CORRECTION) {
-        // Apply vector rotation matrix. ~40 usec
-        r_axisi = r_axis0*sin_T + r_axis1*cos_T;
-        r_axis0 = r_axis0*cos_T - r_axis1*sin_T;
-        r_axis1 = r_axisi;
-        count++;
-      } else {
-        // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments. ~375 usec
-        // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
-        cos_Ti = cos(i*theta_per_segment);
-        sin_Ti = sin(i*theta_per_segment);
-        r_axis0 = -offset[axis_0]*cos_Ti + offset[axis_1]*sin_Ti;
-        r_axis1 = -offset[axis_0]*sin_Ti - offset[axis_1]*cos_Ti;
-        count = 0;
-      }
+    mc_gen.arc.cos_T = 2.0 - mc_gen.arc.theta_per_segment*mc_gen.arc.theta_per_segment;
+    mc_gen.arc.sin_T = mc_gen.arc.theta_per_segment*0.16666667*(mc_gen.arc.cos_T + 4.0);
+    mc_gen.arc.cos_T *= 0.5;
+  }
 
-      // Update arc_target location
-      /*
-      position[axis_0] = center_axis0 + r_axis0;
-      position[axis_1] = center_axis1 + r_axis1;
-      position[axis_linear] += linear_per_segment;
-      * */
-      if (bit_istrue((1<<AXIS_1), axis_0_mask)) {position[AXIS_1] = center_axis0 + r_axis0;}
-      if (bit_istrue((1<<AXIS_2), axis_0_mask)) {position[AXIS_2] = center_axis0 + r_axis0;}
-      if (bit_istrue((1<<AXIS_3), axis_0_mask)) {position[AXIS_3] = center_axis0 + r_axis0;}
-      #if N_AXIS > 3
-        if (bit_istrue((1<<AXIS_4), axis_0_mask)) {position[AXIS_4] = center_axis0 + r_axis0;}
-      #endif
-      #if N_AXIS > 4
-        if (bit_istrue((1<<AXIS_5), axis_0_mask)) {position[AXIS_5] = center_axis0 + r_axis0;}
-      #endif
-      #if N_AXIS > 5
-        if (bit_istrue((1<<AXIS_6), axis_0_mask)) {position[AXIS_6] = center_axis0 + r_axis0;}
-      #endif
+  // Hand the (segments-1) segments and the final one, which arrives exactly at the target, to the
+  // motion generator, once it has queued the motions of a prior block. Then queue as many segments as
+  // the planner buffer takes right away.
+  mc_generator_finish();
+  memcpy(&mc_gen.pl_data, pl_data, sizeof(plan_line_data_t));
+  memcpy(mc_gen.position, position, sizeof(mc_gen.position));
+  memcpy(mc_gen.arc.target, target, sizeof(mc_gen.arc.target));
+  mc_gen.arc.center_axis0 = center_axis0;
+  mc_gen.arc.center_axis1 = center_axis1;
+  mc_gen.arc.offset_axis0 = offset[axis_0];
+  mc_gen.arc.offset_axis1 = offset[axis_1];
+  mc_gen.arc.r_axis0 = r_axis0;
+  mc_gen.arc.r_axis1 = r_axis1;
+  mc_gen.arc.radius = radius;
+  mc_gen.arc.axis_0_mask = axis_0_mask;
+  mc_gen.arc.axis_1_mask = axis_1_mask;
+  mc_gen.arc.segment = 1;
+  mc_gen.arc.segments = segments;
+  mc_gen.step = 0;
+  mc_gen.type = MC_GENERATOR_ARC;
+  mc_generator_run();
+}
 
-      if (bit_istrue((1<<AXIS_1), axis_1_mask)) {position[AXIS_1] = center_axis1 + r_axis1;}
-      if (bit_istrue((1<<AXIS_2), axis_1_mask)) {position[AXIS_2] = center_axis1 + r_axis1;}
-      if (bit_istrue((1<<AXIS_3), axis_1_mask)) {position[AXIS_3] = center_axis1 + r_axis1;}
-      #if N_AXIS > 3
-        if (bit_istrue((1<<AXIS_4), axis_1_mask)) {position[AXIS_4] = center_axis1 + r_axis1;}
-      #endif
-      #if N_AXIS > 4
-        if (bit_istrue((1<<AXIS_5), axis_1_mask)) {position[AXIS_5] = center_axis1 + r_axis1;}
-      #endif
-      #if N_AXIS > 5
-        if (bit_istrue((1<<AXIS_6), axis_1_mask)) {position[AXIS_6] = center_axis1 + r_axis1;}
-      #endif
 
-      if (bit_istrue((1<<AXIS_1), axis_linear_mask)) {position[AXIS_1] += linear_per_segment;}
-      if (bit_istrue((1<<AXIS_2), axis_linear_mask)) {position[AXIS_2] += linear_per_segment;}
-      if (bit_istrue((1<<AXIS_3), axis_linear_mask)) {position[AXIS_3] += linear_per_segment;}
-      #if N_AXIS > 3
-        if (bit_istrue((1<<AXIS_4), axis_linear_mask)) {position[AXIS_4] += linear_per_segment;}
-      #endif
-      #if N_AXIS > 4
-        if (bit_istrue((1<<AXIS_5), axis_linear_mask)) {position[AXIS_5] += linear_per_segment;}
-      #endif
-      #if N_AXIS > 5
-        if (bit_istrue((1<<AXIS_6), axis_linear_mask)) {position[AXIS_6] += linear_per_segment;}
-      #endif
+// Computes the next arc segment end point into mc_gen.position. The last one is the arc target.
+static void mc_arc_step()
+{
+  #ifdef ARC_CURVATURE_JUNCTION_SPEED
+    // Every segment but the first continues the arc, so the planner plans their junctions from the radius.
+    if (mc_gen.arc.segment > 1) { mc_gen.pl_data.arc_radius = mc_gen.arc.radius; }
+  #endif
+  if (mc_gen.arc.segment < mc_gen.arc.segments) {
+    if (mc_gen.step < N_ARC_CORRECTION) {
+      // Apply vector rotation matrix. ~40 usec
+      float r_axisi = mc_gen.arc.r_axis0*mc_gen.arc.sin_T + mc_gen.arc.r_axis1*mc_gen.arc.cos_T;
+      mc_gen.arc.r_axis0 = mc_gen.arc.r_axis0*mc_gen.arc.cos_T - mc_gen.arc.r_axis1*mc_gen.arc.sin_T;
+      mc_gen.arc.r_axis1 = r_axisi;
+      mc_gen.step++;
+    } else {
+      // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments. ~375 usec
+      // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
+      float cos_Ti = cos(mc_gen.arc.segment*mc_gen.arc.theta_per_segment);
+      float sin_Ti = sin(mc_gen.arc.segment*mc_gen.arc.theta_per_segment);
+      mc_gen.arc.r_axis0 = -mc_gen.arc.offset_axis0*cos_Ti + mc_gen.arc.offset_axis1*sin_Ti;
+      mc_gen.arc.r_axis1 = -mc_gen.arc.offset_axis0*sin_Ti - mc_gen.arc.offset_axis1*cos_Ti;
+      mc_gen.step = 0;
+    }
 
-      if ( axis_a_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_a_mask)) {position[AXIS_1] += a_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_a_mask)) {position[AXIS_2] += a_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_a_mask)) {position[AXIS_3] += a_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_a_mask)) {position[AXIS_4] += a_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_a_mask)) {position[AXIS_5] += a_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_a_mask)) {position[AXIS_6] += a_per_segment;}
-        #endif
-      }
+    // Update arc_target location
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (bit_istrue(mc_gen.arc.axis_0_mask,bit(idx))) { mc_gen.position[idx] = mc_gen.arc.center_axis0 + mc_gen.arc.r_axis0; }
+      else if (bit_istrue(mc_gen.arc.axis_1_mask,bit(idx))) { mc_gen.position[idx] = mc_gen.arc.center_axis1 + mc_gen.arc.r_axis1; }
+      else { mc_gen.position[idx] += mc_gen.arc.linear_per_segment[idx]; }
+    }
+    mc_gen.arc.segment++;
+  } else {
+    // Ensure last segment arrives at target location.
+    memcpy(mc_gen.position, mc_gen.arc.target, sizeof(mc_gen.position));
+    mc_gen.type = MC_GENERATOR_NONE;
+  }
+}
 
-      if ( axis_b_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_b_mask)) {position[AXIS_1] += b_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_b_mask)) {position[AXIS_2] += b_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_b_mask)) {position[AXIS_3] += b_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_b_mask)) {position[AXIS_4] += b_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_b_mask)) {position[AXIS_5] += b_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_b_mask)) {position[AXIS_6] += b_per_segment;}
-        #endif
-      }
 
-      if ( axis_c_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_c_mask)) {position[AXIS_1] += c_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_c_mask)) {position[AXIS_2] += c_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_c_mask)) {position[AXIS_3] += c_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_c_mask)) {position[AXIS_4] += c_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_c_mask)) {position[AXIS_5] += c_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_c_mask)) {position[AXIS_6] += c_per_segment;}
-        #endif
-      }
+#ifdef ENABLE_WELL_PLATE_CYCLE
+  // Visits a grid of wells. At each well, moves over it at the retract height, feeds down to the well
+  // depth and retracts. Starts with a rise to the retract height, if below it, at the current position.
+  // Rows are visited in serpentine order. target is the first well at depth and returns the final
+  // position, retracted above the last well. Motions are queued by the motion generator.
+  void mc_plate_cycle(float *target, plan_line_data_t *pl_data, float column_pitch, float row_pitch,
+    uint8_t columns, uint8_t rows, float rise)
+  {
+    // In check mode, only the final position is needed.
+    if (sys.state != STATE_CHECK_MODE) {
+      mc_generator_finish(); // Queue the motions still pending from a prior block first.
+      memcpy(&mc_gen.pl_data, pl_data, sizeof(plan_line_data_t));
+      memcpy(mc_gen.position, gc_state.position, sizeof(mc_gen.position));
+      memcpy(mc_gen.plate.origin, target, sizeof(mc_gen.plate.origin));
+      mc_gen.plate.column_pitch = column_pitch;
+      mc_gen.plate.row_pitch = row_pitch;
+      mc_gen.plate.rise = rise;
+      mc_gen.plate.columns = columns;
+      mc_gen.plate.well = 0;
+      mc_gen.plate.n_well = (uint16_t)columns*rows;
+      mc_gen.step = PLATE_RISE;
+      mc_gen.type = MC_GENERATOR_PLATE;
+      mc_generator_run(); // Fill the planner buffer right away.
+    }
 
-      if ( axis_u_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_u_mask)) {position[AXIS_1] += u_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_u_mask)) {position[AXIS_2] += u_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_u_mask)) {position[AXIS_3] += u_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_u_mask)) {position[AXIS_4] += u_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_u_mask)) {position[AXIS_5] += u_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_u_mask)) {position[AXIS_6] += u_per_segment;}
-        #endif
-      }
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (bit_istrue(AXIS_LETTER_MASK('X'),bit(idx))) {
+        if (rows & 1) { target[idx] += column_pitch*(columns-1); } // Else, ends on the first column.
+      } else if (bit_istrue(AXIS_LETTER_MASK('Y'),bit(idx))) { target[idx] += row_pitch*(rows-1); }
+      else if (bit_istrue(AXIS_LETTER_MASK('Z'),bit(idx))) { target[idx] += rise; }
+    }
+  }
 
-      if ( axis_v_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_v_mask)) {position[AXIS_1] += v_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_v_mask)) {position[AXIS_2] += v_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_v_mask)) {position[AXIS_3] += v_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_v_mask)) {position[AXIS_4] += v_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_v_mask)) {position[AXIS_5] += v_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_v_mask)) {position[AXIS_6] += v_per_segment;}
-        #endif
-      }
 
-      if ( axis_w_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_w_mask)) {position[AXIS_1] += w_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_w_mask)) {position[AXIS_2] += w_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_w_mask)) {position[AXIS_3] += w_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_w_mask)) {position[AXIS_4] += w_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_w_mask)) {position[AXIS_5] += w_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_w_mask)) {position[AXIS_6] += w_per_segment;}
-        #endif
+  // Computes the next motion of the well plate cycle into mc_gen.position. Returns true for the feed
+  // motion into the well, and false for the rapid motions.
+  static uint8_t mc_plate_cycle_step()
+  {
+    uint8_t row = mc_gen.plate.well/mc_gen.plate.columns;
+    uint8_t column = mc_gen.plate.well%mc_gen.plate.columns;
+    if (row & 1) { column = mc_gen.plate.columns-1-column; } // Odd rows are visited backwards.
+    uint8_t step = mc_gen.step;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (bit_istrue(AXIS_LETTER_MASK('Z'),bit(idx))) {
+        float retract = mc_gen.plate.origin[idx]+mc_gen.plate.rise;
+        if (step == PLATE_FEED) { mc_gen.position[idx] = mc_gen.plate.origin[idx]; }
+        else if ((step != PLATE_MOVE) && ((step != PLATE_RISE) || (mc_gen.position[idx] < retract))) {
+          mc_gen.position[idx] = retract;
+        }
+      } else if (step == PLATE_MOVE) {
+        if (bit_istrue(AXIS_LETTER_MASK('X'),bit(idx))) { mc_gen.position[idx] = mc_gen.plate.origin[idx]+column*mc_gen.plate.column_pitch; }
+        else if (bit_istrue(AXIS_LETTER_MASK('Y'),bit(idx))) { mc_gen.position[idx] = mc_gen.plate.origin[idx]+row*mc_gen.plate.row_pitch; }
       }
+    }
 
-      if ( axis_d_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_d_mask)) {position[AXIS_1] += d_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_d_mask)) {position[AXIS_2] += d_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_d_mask)) {position[AXIS_3] += d_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_d_mask)) {position[AXIS_4] += d_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_d_mask)) {position[AXIS_5] += d_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_d_mask)) {position[AXIS_6] += d_per_segment;}
-        #endif
-      }
+    if (step == PLATE_RETRACT) {
+      mc_gen.step = PLATE_MOVE;
+      if (++mc_gen.plate.well == mc_gen.plate.n_well) { mc_gen.type = MC_GENERATOR_NONE; }
+    } else {
+      mc_gen.step++;
+    }
+    return(step == PLATE_FEED);
+  }
+#endif
 
-      if ( axis_e_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_e_mask)) {position[AXIS_1] += e_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_e_mask)) {position[AXIS_2] += e_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_e_mask)) {position[AXIS_3] += e_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_e_mask)) {position[AXIS_4] += e_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_e_mask)) {position[AXIS_5] += e_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_e_mask)) {position[AXIS_6] += e_per_segment;}
-        #endif
-      }
 
-      if ( axis_h_mask ) {
-        if (bit_istrue((1<<AXIS_1), axis_h_mask)) {position[AXIS_1] += h_per_segment;}
-        if (bit_istrue((1<<AXIS_2), axis_h_mask)) {position[AXIS_2] += h_per_segment;}
-        if (bit_istrue((1<<AXIS_3), axis_h_mask)) {position[AXIS_3] += h_per_segment;}
-        #if N_AXIS > 3
-          if (bit_istrue((1<<AXIS_4), axis_h_mask)) {position[AXIS_4] += h_per_segment;}
-        #endif
-        #if N_AXIS > 4
-          if (bit_istrue((1<<AXIS_5), axis_h_mask)) {position[AXIS_5] += h_per_segment;}
-        #endif
-        #if N_AXIS > 5
-          if (bit_istrue((1<<AXIS_6), axis_h_mask)) {position[AXIS_6] += h_per_segment;}
-        #endif
-      }
+// Queues the next motion of the active motion generator. Motions without any travel are skipped.
+static void mc_generator_step()
+{
+  float target[N_AXIS];
+  memcpy(target,mc_gen.position,sizeof(target));
+  uint8_t is_feed = false;
+  switch (mc_gen.type) {
+    case MC_GENERATOR_ARC: mc_arc_step(); is_feed = true; break;
+    #ifdef ENABLE_WELL_PLATE_CYCLE
+      case MC_GENERATOR_PLATE: is_feed = mc_plate_cycle_step(); break;
+    #endif
+  }
+  if (isequal_position_vector(target,mc_gen.position)) { return; }
+
+  if (is_feed) { bit_false(mc_gen.pl_data.condition,PL_COND_FLAG_RAPID_MOTION); }
+  else { bit_true(mc_gen.pl_data.condition,PL_COND_FLAG_RAPID_MOTION); }
+  memcpy(target,mc_gen.position,sizeof(target));
+  mc_plan_line(target, &mc_gen.pl_data);
+}
 
-      mc_line(position, pl_data);
 
-      // Bail mid-circle on system abort. Runtime command check already performed by mc_line.
-      if (sys.abort) { return; }
-    }
+// Queues the pending generator motions, while there is room in the planner buffer. Never blocks, but
+// to queue all the segments of a motion split by the height map.
+// NOTE: Never called from protocol_execute_realtime(), which mc_line() calls, to avoid any recursion.
+void mc_generator_run()
+{
+  while (mc_gen.type && !plan_check_full_buffer()) {
+    mc_generator_step();
+    if (sys.abort) { return; }
+  }
+}
+
+
+// Queues all the pending generator motions. Blocks, as mc_line() does, while the planner buffer is full.
+void mc_generator_finish()
+{
+  while (mc_gen.type) {
+    mc_generator_step();
+    if (sys.abort) { return; }
   }
-  // Ensure last segment arrives at target location.
-  mc_line(target, pl_data);
 }
 
 
@@ -454,7 +633,22 @@ void mc_homing_cycle(uint8_t cycle_mask)
 
 // Perform tool length probe cycle. Requires probe switch.
 // NOTE: Upon probe failure, the program will be stopped and placed into ALARM state.
-uint8_t mc_probe_cycle(float *target, plan_line_data_t *pl_data, uint8_t parser_flags)
+// Records and reports the result of a completed probing cycle.
+static void mc_probe_finish(uint8_t probe_result, plan_line_data_t *pl_data)
+{
+  if ((probe_result != GC_PROBE_FOUND) && (probe_result != GC_PROBE_FAIL_END)) { return; }
+  #ifdef ENABLE_PROBE_RESULT_BUFFER
+    probe_store_result(pl_data->line_number);
+  #endif
+  #ifdef MESSAGE_PROBE_COORDINATES
+    // All done! Output the probe position as message.
+    report_probe_parameters();
+  #endif
+}
+
+
+// Executes a single probing motion to the target. The probe position is left in sys_probe_position.
+static uint8_t mc_probe_move(float *target, plan_line_data_t *pl_data, uint8_t parser_flags)
 {
   // TODO: Need to update this cycle so it obeys a non-auto cycle start.
   if (sys.state == STATE_CHECK_MODE) { return(GC_PROBE_CHECK_MODE); }
@@ -482,6 +676,9 @@ uint8_t mc_probe_cycle(float *target, plan_line_data_t *pl_data, uint8_t parser_
   mc_line(target, pl_data);
 
   // Activate the probing state monitor in the stepper module.
+  #ifdef ENABLE_PROBE_CAPTURE
+    probe_capture_reset();
+  #endif
   sys_probe_state = PROBE_ACTIVE;
 
   // Perform probing cycle. Wait here until probe is triggered or motion completes.
@@ -511,16 +708,66 @@ uint8_t mc_probe_cycle(float *target, plan_line_data_t *pl_data, uint8_t parser_
   plan_reset(); // Reset planner buffer. Zero planner positions. Ensure probing motion is cleared.
   plan_sync_position(); // Sync planner position to current machine position.
 
-  #ifdef MESSAGE_PROBE_COORDINATES
-    // All done! Output the probe position as message.
-    report_probe_parameters();
-  #endif
-
   if (sys.probe_succeeded) { return(GC_PROBE_FOUND); } // Successful probe cycle.
   else { return(GC_PROBE_FAIL_END); } // Failed to trigger probe within travel. With or without error.
 }
 
 
+uint8_t mc_probe_cycle(float *target, plan_line_data_t *pl_data, uint8_t parser_flags)
+{
+  if (sys.state == STATE_CHECK_MODE) { return(GC_PROBE_CHECK_MODE); }
+
+  uint8_t probe_result = mc_probe_move(target, pl_data, parser_flags);
+  mc_probe_finish(probe_result, pl_data);
+  return(probe_result);
+}
+
+
+#ifdef ENABLE_TWO_STAGE_PROBE
+  // Two-stage probe cycle. Seeks the probe at the programmed feed rate, backs off the contact by the
+  // retract distance toward the start position, then touches again at the slow feed rate. Only the
+  // final probe result is reported. A failed seek ends the cycle as a single probe would.
+  uint8_t mc_probe_cycle_two_stage(float *target, plan_line_data_t *pl_data, uint8_t parser_flags,
+                                   float slow_feed_rate, float retract)
+  {
+    if (sys.state == STATE_CHECK_MODE) { return(GC_PROBE_CHECK_MODE); }
+
+    // Record the start position to retract toward it.
+    protocol_buffer_synchronize();
+    if (sys.abort) { return(GC_PROBE_ABORT); }
+    float start[N_AXIS];
+    system_convert_array_steps_to_mpos(start, sys_position);
+    mc_convert_to_program_position(start);
+
+    uint8_t probe_result = mc_probe_move(target, pl_data, parser_flags);
+    if (probe_result == GC_PROBE_FOUND) {
+      float retract_target[N_AXIS];
+      float contact[N_AXIS];
+      probe_get_position(contact);
+      mc_convert_to_program_position(contact);
+      uint8_t idx;
+      float distance = 0.0;
+      for (idx=0; idx<N_AXIS; idx++) {
+        retract_target[idx] = start[idx]-contact[idx];
+        distance += retract_target[idx]*retract_target[idx];
+      }
+      distance = sqrt(distance);
+      // Retract along the probing direction, but never past the start position.
+      float ratio = (retract < distance) ? retract/distance : 1.0;
+      for (idx=0; idx<N_AXIS; idx++) { retract_target[idx] = contact[idx]+ratio*retract_target[idx]; }
+      mc_line(retract_target, pl_data);
+
+      // Touch again at the slow feed rate. Waits for the retract motion before probing.
+      pl_data->feed_rate = slow_feed_rate;
+      probe_result = mc_probe_move(target, pl_data, parser_flags);
+    }
+
+    mc_probe_finish(probe_result, pl_data);
+    return(probe_result);
+  }
+#endif
+
+
 // Plans and executes the single special motion case for parking. Independent of main planner buffer.
 // NOTE: Uses the always free planner ring buffer head to store motion parameters for execution.
 #ifdef PARKING_ENABLE
@@ -30,21 +30,36 @@
 
 #define HOMING_CYCLE_ALL  0  // Must be zero.
 
+// Initialize the motion control. Clears any pending motion generator. Called upon every reset.
+void mc_init();
+
 // Execute linear motion in absolute millimeter coordinates. Feed rate given in millimeters/second
 // unless invert_feed_rate is true. Then the feed_rate means that the motion should be completed in
-// (1 minute)/feed_rate time.
+// (1 minute)/feed_rate time. Queues the pending motions of a motion generator first.
 void mc_line(float *target, plan_line_data_t *pl_data);
 
 // Execute an arc in offset mode format. position == current xyz, target == target xyz,
-// offset == offset from current xyz, axis_XXX defines circle plane in tool space, axis_linear is
-// the direction of helical travel, radius == circle radius, is_clockwise_arc boolean. Used
-// for vector transformation direction.
+// offset == offset from current xyz, axis_XXX defines circle plane in tool space, axis_XXX_mask
+// includes its clones, radius == circle radius, is_clockwise_arc boolean. Used for vector
+// transformation direction. All other axes move linearly, which includes helical travel.
+// The segments are queued by the motion generator, so the call returns without waiting on the planner.
 void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
-  uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t axis_0_mask, uint8_t axis_1_mask, uint8_t axis_linear_mask,
-  uint8_t axis_a, uint8_t axis_b, uint8_t axis_c, uint8_t axis_a_mask, uint8_t axis_b_mask, uint8_t axis_c_mask,
-  uint8_t axis_u, uint8_t axis_v, uint8_t axis_w, uint8_t axis_u_mask, uint8_t axis_v_mask, uint8_t axis_w_mask,
-  uint8_t axis_d, uint8_t axis_e, uint8_t axis_h, uint8_t axis_d_mask, uint8_t axis_e_mask, uint8_t axis_h_mask,
-  uint8_t is_clockwise_arc);
+  uint8_t axis_0, uint8_t axis_1, uint8_t axis_0_mask, uint8_t axis_1_mask, uint8_t is_clockwise_arc);
+
+#ifdef ENABLE_WELL_PLATE_CYCLE
+  // Visit a grid of wells, column_pitch and row_pitch apart, feeding down to the target depth and
+  // retracting by rise at each well. target is the first well, and returns the final position.
+  void mc_plate_cycle(float *target, plan_line_data_t *pl_data, float column_pitch, float row_pitch,
+    uint8_t columns, uint8_t rows, float rise);
+#endif
+
+// Queue the pending motions of a motion generator while the planner buffer has room, without blocking.
+void mc_generator_run();
+
+// Queue all the pending motions of a motion generator. Blocks while the planner buffer is full.
+// NOTE: Only called ahead of another motion, or where the planner must hold all the motions, such as
+// a buffer sync or a height map change. Other blocks are parsed and executed while it is pending.
+void mc_generator_finish();
 
 // Dwell for a specific number of seconds
 void mc_dwell(float seconds);
@@ -52,9 +67,26 @@ void mc_dwell(float seconds);
 // Perform homing cycle to locate machine zero. Requires limit switches.
 void mc_homing_cycle(uint8_t cycle_mask);
 
+// Converts a programmed position to machine coordinates, with the coordinate transform and height map.
+// G53 motions are flagged by PL_COND_FLAG_MACHINE_COORD in condition.
+void mc_convert_to_machine_position(float *position, uint16_t condition);
+
+// Returns true if the box of programmed positions exceeds the machine travel, once compensated.
+uint8_t mc_check_travel_limits_box(float *box_min, float *box_max);
+
+// Converts a machine position to the programmed position, without the height map and coordinate
+// transform compensations.
+void mc_convert_to_program_position(float *position);
+
 // Perform tool length probe cycle. Requires probe switch.
 uint8_t mc_probe_cycle(float *target, plan_line_data_t *pl_data, uint8_t parser_flags);
 
+#ifdef ENABLE_TWO_STAGE_PROBE
+  // Perform a fast seek, retract and slow re-touch probe cycle. Reports only the final result.
+  uint8_t mc_probe_cycle_two_stage(float *target, plan_line_data_t *pl_data, uint8_t parser_flags,
+                                   float slow_feed_rate, float retract);
+#endif
+
 // Handles updating the override control state.
 void mc_override_ctrl_update(uint8_t override_state);
 
@@ -25,6 +25,16 @@
 
 #define MAX_INT_DIGITS 8 // Maximum number of digits in int32 (and float)
 
+const __flash uint8_t axis_letter_mask[26] = {
+  AXIS_LETTER_MASK('A'), AXIS_LETTER_MASK('B'), AXIS_LETTER_MASK('C'), AXIS_LETTER_MASK('D'),
+  AXIS_LETTER_MASK('E'), AXIS_LETTER_MASK('F'), AXIS_LETTER_MASK('G'), AXIS_LETTER_MASK('H'),
+  AXIS_LETTER_MASK('I'), AXIS_LETTER_MASK('J'), AXIS_LETTER_MASK('K'), AXIS_LETTER_MASK('L'),
+  AXIS_LETTER_MASK('M'), AXIS_LETTER_MASK('N'), AXIS_LETTER_MASK('O'), AXIS_LETTER_MASK('P'),
+  AXIS_LETTER_MASK('Q'), AXIS_LETTER_MASK('R'), AXIS_LETTER_MASK('S'), AXIS_LETTER_MASK('T'),
+  AXIS_LETTER_MASK('U'), AXIS_LETTER_MASK('V'), AXIS_LETTER_MASK('W'), AXIS_LETTER_MASK('X'),
+  AXIS_LETTER_MASK('Y'), AXIS_LETTER_MASK('Z')
+};
+
 
 // Extracts a floating point value from a string. The following code is based loosely on
 // the avr-libc strtod() function by Michael Stumpf and Dmitry Xmelkov and many freely
@@ -33,7 +43,9 @@
 // Scientific notation is officially not supported by g-code, and the 'E' character may
 // be a g-code word on some CNC systems. So, 'E' notation will not be recognized.
 // NOTE: Thanks to Radu-Eosif Mihailescu for identifying the issues with using strtod().
-uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
+// The integer part and the two decimal mantissa are tracked as fixed-point values while the
+// digits are read, so g-code command words need no floating point trunc() or round().
+uint8_t read_float_fixed(char *line, uint8_t *char_counter, float *float_ptr, int32_t *int_ptr, uint8_t *mantissa_ptr)
 {
   char *ptr = line + *char_counter;
   unsigned char c;
@@ -52,8 +64,11 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
 
   // Extract number into fast integer. Track decimal in terms of exponent value.
   uint32_t intval = 0;
+  uint32_t intpart = 0;
   int8_t exp = 0;
   uint8_t ndigit = 0;
+  uint8_t nfraction = 0;
+  uint8_t mantissa = 0;
   bool isdecimal = false;
   while(1) {
     c -= '0';
@@ -65,8 +80,16 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
       } else {
         if (!(isdecimal)) { exp++; }  // Drop overflow digits
       }
+      if (isdecimal) {
+        // Fixed-point mantissa in hundredths, rounded half up on the third decimal.
+        nfraction++;
+        if (nfraction == 1) { mantissa = (((c << 2) + c) << 1); } // c*10
+        else if (nfraction == 2) { mantissa += c; }
+        else if (nfraction == 3) { if (c >= 5) { mantissa++; } }
+      }
     } else if (c == (('.'-'0') & 0xff)  &&  !(isdecimal)) {
       isdecimal = true;
+      intpart = intval;
     } else {
       break;
     }
@@ -76,6 +99,13 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
   // Return if no digits have been read.
   if (!ndigit) { return(false); };
 
+  // Export the integer part, truncated toward zero. More than MAX_INT_DIGITS integer digits saturate.
+  if (!(isdecimal)) { intpart = intval; }
+  if (exp > 0) { intpart = 0x7FFFFFFF; }
+  if (isnegative) { *int_ptr = -(int32_t)intpart; }
+  else { *int_ptr = intpart; }
+  *mantissa_ptr = mantissa;
+
   // Convert integer into floating point.
   float fval;
   fval = (float)intval;
@@ -109,6 +139,14 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
 }
 
 
+uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
+{
+  int32_t int_value;
+  uint8_t mantissa;
+  return(read_float_fixed(line, char_counter, float_ptr, &int_value, &mantissa));
+}
+
+
 // Non-blocking delay function used for general operation and suspend features.
 void delay_sec(float seconds, uint8_t mode)
 {
@@ -164,19 +202,11 @@ float hypot_f(float x, float y) { return(sqrt(x*x + y*y)); }
 
 float convert_delta_vector_to_unit_vector(float *vector)
 {
-  uint8_t idx, j;
-  bool isclone;
+  uint8_t idx;
   float magnitude = 0.0;
   for (idx=0; idx<N_AXIS; idx++) {
-    isclone = false;
-    for (j=0; j<idx; j++) { // search if is a clone axis (same name than precedent axis)
-      if (axis_name[j] == axis_name[idx]) {
-        isclone = true;
-        break;
-      }
-    }
     if (vector[idx] != 0.0) {
-      if (isclone == false) { // Avoid count axis multiple time in case of axis cloning
+      if (bit_isfalse(AXIS_CLONE_MASK,bit(idx))) { // Avoid count axis multiple time in case of axis cloning
         magnitude += vector[idx]*vector[idx];
       }
     }
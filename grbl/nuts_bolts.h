@@ -59,11 +59,47 @@
 #define bit_istrue(x,mask) ((x & mask) != 0)
 #define bit_isfalse(x,mask) ((x & mask) == 0)
 
+// Axis word letter to axis bitmask and axis index, resolved at compile time from the AXIS_*_NAME
+// definitions in config.h. Cloned axes share a letter and set several mask bits. The mask is zero and
+// the index is AXIS_1, if no axis has this letter. AXIS_CLONE_MASK flags each axis whose letter is
+// already used by a lower axis, so a cloned motion is only accounted for once.
+#define AXIS_NAME_BIT(n,letter) ((AXIS_##n##_NAME == (letter)) ? bit(AXIS_##n) : 0)
+#define AXIS_CLONE_BIT(n) ((AXIS_LETTER_MASK(AXIS_##n##_NAME) & (bit(AXIS_##n)-1)) ? bit(AXIS_##n) : 0)
+#if N_AXIS > 5
+  #define AXIS_LETTER_MASK(letter) (AXIS_NAME_BIT(1,letter) | AXIS_NAME_BIT(2,letter) | AXIS_NAME_BIT(3,letter) | \
+                                    AXIS_NAME_BIT(4,letter) | AXIS_NAME_BIT(5,letter) | AXIS_NAME_BIT(6,letter))
+  #define AXIS_CLONE_MASK (AXIS_CLONE_BIT(2) | AXIS_CLONE_BIT(3) | AXIS_CLONE_BIT(4) | AXIS_CLONE_BIT(5) | AXIS_CLONE_BIT(6))
+#elif N_AXIS > 4
+  #define AXIS_LETTER_MASK(letter) (AXIS_NAME_BIT(1,letter) | AXIS_NAME_BIT(2,letter) | AXIS_NAME_BIT(3,letter) | \
+                                    AXIS_NAME_BIT(4,letter) | AXIS_NAME_BIT(5,letter))
+  #define AXIS_CLONE_MASK (AXIS_CLONE_BIT(2) | AXIS_CLONE_BIT(3) | AXIS_CLONE_BIT(4) | AXIS_CLONE_BIT(5))
+#elif N_AXIS > 3
+  #define AXIS_LETTER_MASK(letter) (AXIS_NAME_BIT(1,letter) | AXIS_NAME_BIT(2,letter) | AXIS_NAME_BIT(3,letter) | \
+                                    AXIS_NAME_BIT(4,letter))
+  #define AXIS_CLONE_MASK (AXIS_CLONE_BIT(2) | AXIS_CLONE_BIT(3) | AXIS_CLONE_BIT(4))
+#else
+  #define AXIS_LETTER_MASK(letter) (AXIS_NAME_BIT(1,letter) | AXIS_NAME_BIT(2,letter) | AXIS_NAME_BIT(3,letter))
+  #define AXIS_CLONE_MASK (AXIS_CLONE_BIT(2) | AXIS_CLONE_BIT(3))
+#endif
+#define AXIS_LETTER_INDEX(letter) ((AXIS_LETTER_MASK(letter) & bit(0)) ? 0 : (AXIS_LETTER_MASK(letter) & bit(1)) ? 1 : \
+                                   (AXIS_LETTER_MASK(letter) & bit(2)) ? 2 : (AXIS_LETTER_MASK(letter) & bit(3)) ? 3 : \
+                                   (AXIS_LETTER_MASK(letter) & bit(4)) ? 4 : (AXIS_LETTER_MASK(letter) & bit(5)) ? 5 : AXIS_1)
+
+// Axis word letter to axis bitmask lookup table for letters parsed at runtime. Indexed from 'A', so
+// the letter must be an uppercase 'A' to 'Z'.
+extern const __flash uint8_t axis_letter_mask[26];
+#define get_axis_letter_mask(letter) (axis_letter_mask[(letter)-'A'])
+
 // Read a floating point value from a string. Line points to the input buffer, char_counter
 // is the indexer pointing to the current character of the line, while float_ptr is
 // a pointer to the result variable. Returns true when it succeeds
 uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr);
 
+// Same as read_float(), but also returns the integer part of the value, truncated toward zero, and
+// its first two decimals as a 0-100 mantissa, rounded on the third. Used by the g-code parser to
+// identify command words, like G38.2, without floating point trunc() and round() calls.
+uint8_t read_float_fixed(char *line, uint8_t *char_counter, float *float_ptr, int32_t *int_ptr, uint8_t *mantissa_ptr);
+
 // Non-blocking delay function used for general operation and suspend features.
 void delay_sec(float seconds, uint8_t mode);
 
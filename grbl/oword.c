@@ -0,0 +1,812 @@
+/*
+  oword.c - o-word subroutines stored in EEPROM
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_O_WORD_SUBROUTINES
+
+#define OWORD_NONE 0 // O-word number of a free slot, or of no definition in progress.
+
+// Each subroutine slot holds a header, the header checksum, and the body. The body is a series of
+// null terminated lines, as they were received after the preprocessing of protocol_main_loop().
+#define OWORD_SLOT_ADDR(slot) (EEPROM_ADDR_SUBROUTINES+(slot)*OWORD_SUB_SIZE)
+#define OWORD_BODY_SIZE (OWORD_SUB_SIZE-sizeof(oword_header_t)-1)
+
+// Define o-word keywords, as they follow the o-word number. NOTE: In this and the tables below, a
+// name must be listed before any shorter name it starts with.
+#define OWORD_KEYWORD_SUB        0
+#define OWORD_KEYWORD_ENDSUB     1
+#define OWORD_KEYWORD_CALL       2
+#define OWORD_KEYWORD_RETURN     3
+#define OWORD_KEYWORD_WHILE      4
+#define OWORD_KEYWORD_ENDWHILE   5
+#define OWORD_KEYWORD_REPEAT     6
+#define OWORD_KEYWORD_ENDREPEAT  7
+#define OWORD_KEYWORD_BREAK      8
+#define OWORD_KEYWORD_CONTINUE   9
+#define OWORD_KEYWORD_IF         10
+#define OWORD_KEYWORD_ELSEIF     11
+#define OWORD_KEYWORD_ELSE       12
+#define OWORD_KEYWORD_ENDIF      13
+#define N_OWORD_KEYWORD          14
+#define OWORD_KEYWORD_NONE       N_OWORD_KEYWORD
+
+static const __flash char oword_keyword[N_OWORD_KEYWORD][10] = {
+  "SUB", "ENDSUB", "CALL", "RETURN", "WHILE", "ENDWHILE", "REPEAT", "ENDREPEAT", "BREAK", "CONTINUE",
+  "IF", "ELSEIF", "ELSE", "ENDIF" };
+
+// Define expression binary operators, in order of decreasing precedence. See oword_precedence().
+#define OWORD_OP_POWER     0
+#define OWORD_OP_MULTIPLY  1
+#define OWORD_OP_DIVIDE    2
+#define OWORD_OP_MODULO    3
+#define OWORD_OP_ADD       4
+#define OWORD_OP_SUBTRACT  5
+#define OWORD_OP_EQ        6
+#define OWORD_OP_NE        7
+#define OWORD_OP_GT        8
+#define OWORD_OP_GE        9
+#define OWORD_OP_LT        10
+#define OWORD_OP_LE        11
+#define OWORD_OP_AND       12
+#define OWORD_OP_OR        13
+#define OWORD_OP_XOR       14
+#define N_OWORD_OP         15
+
+static const __flash char oword_operator[N_OWORD_OP][4] = {
+  "**", "*", "/", "MOD", "+", "-", "EQ", "NE", "GT", "GE", "LT", "LE", "AND", "OR", "XOR" };
+
+// Define expression functions. Each takes a bracketed argument, as in ABS[#1]. Angles are in degrees.
+#define OWORD_FN_ABS    0
+#define OWORD_FN_ACOS   1
+#define OWORD_FN_ASIN   2
+#define OWORD_FN_COS    3
+#define OWORD_FN_EXP    4
+#define OWORD_FN_FIX    5
+#define OWORD_FN_FUP    6
+#define OWORD_FN_LN     7
+#define OWORD_FN_ROUND  8
+#define OWORD_FN_SIN    9
+#define OWORD_FN_SQRT   10
+#define OWORD_FN_TAN    11
+#define N_OWORD_FN      12
+
+static const __flash char oword_function[N_OWORD_FN][6] = {
+  "ABS", "ACOS", "ASIN", "COS", "EXP", "FIX", "FUP", "LN", "ROUND", "SIN", "SQRT", "TAN" };
+
+// Define numbered parameters. Call arguments start at #1. Global parameters start at #31, and are
+// kept between calls. Both can be set, as in #31=[#1*2]. The others are read-only system values.
+// NOTE: Axis values are in axis order, X being the first of six. Positions are in work coordinates,
+// and all axis values are in the current units.
+#define OWORD_PARAM_GLOBAL          31
+#define OWORD_PARAM_PROBE           5061 // Last probe position, #5061-#5066
+#define OWORD_PARAM_PROBE_SUCCEEDED 5070 // 1 if the last probing cycle found the probe, 0 if not.
+#define OWORD_PARAM_G28             5161 // G28 position in machine coordinates, #5161-#5166
+#define OWORD_PARAM_G30             5181 // G30 position in machine coordinates, #5181-#5186
+#define OWORD_PARAM_G92             5211 // G92 offsets, #5211-#5216
+#define OWORD_PARAM_COORD_SELECT    5220 // Current coordinate system, 1 for G54 to 6 for G59, 9+P for G54.1 P.
+#define OWORD_PARAM_G54             5221 // G54 offsets, #5221-#5226, then G55 from #5241, and so on.
+#define OWORD_PARAM_G54_SPACING     20
+#define OWORD_PARAM_POSITION        5420 // Current position, #5420-#5425
+
+typedef struct {
+  uint16_t number;  // O-word number of the stored subroutine. OWORD_NONE if the slot is free.
+  uint16_t length;  // Body length in bytes.
+  uint8_t checksum; // Body checksum.
+} oword_header_t;
+
+typedef struct {
+  uint16_t number;  // O-word number of the running subroutine.
+  uint16_t addr;    // EEPROM address of the body.
+  uint16_t length;  // Body length in bytes.
+  uint16_t pc;      // Body offset of the next line to execute.
+  float parameter[OWORD_MAX_PARAMETERS]; // Call arguments. Read as #1, #2, ...
+} oword_frame_t;
+
+typedef struct {
+  uint16_t number;  // O-word number being defined. OWORD_NONE while lines are executed.
+  uint16_t addr;    // EEPROM address of the slot being written.
+  uint16_t length;  // Body length stored so far.
+  uint8_t checksum; // Body checksum so far.
+  uint8_t status;   // Error that failed the definition. Reported up to the ENDSUB line.
+} oword_define_t;
+
+typedef struct {
+  uint16_t number;  // O-word number of the repeat loop.
+  uint8_t depth;    // Call depth of the subroutine running the loop.
+  uint16_t pc;      // Body offset of the first line of the loop.
+  uint32_t count;   // Remaining number of repeats.
+} oword_repeat_t;
+
+// Frame 0 stands for the streamed lines outside of any call. Its arguments are only set by assignments.
+static oword_frame_t oword_frame[OWORD_MAX_CALL_DEPTH+1];
+static uint8_t oword_depth;
+static oword_define_t oword_define;
+// Repeat loops of all running subroutines, innermost last. While loops need no state.
+static oword_repeat_t oword_repeat[OWORD_MAX_REPEAT_DEPTH];
+static uint8_t oword_repeat_depth;
+static float oword_global[OWORD_GLOBAL_PARAMETERS];
+
+
+void oword_init()
+{
+  memset(&oword_frame, 0, sizeof(oword_frame));
+  oword_depth = 0;
+  memset(&oword_define, 0, sizeof(oword_define_t));
+  oword_repeat_depth = 0;
+  memset(&oword_global, 0, sizeof(oword_global));
+}
+
+
+uint8_t oword_is_defining() { return(oword_define.number != OWORD_NONE); }
+
+
+static uint8_t oword_checksum(uint8_t checksum, char data)
+{
+  return(((checksum << 1) | (checksum >> 7)) + data);
+}
+
+
+// Reads the header of a slot. A slot with a corrupted header, as in a blank EEPROM, is free.
+static void oword_read_header(uint8_t slot, oword_header_t *header)
+{
+  if (!(memcpy_from_eeprom_with_checksum((char*)header, OWORD_SLOT_ADDR(slot), sizeof(oword_header_t)))) {
+    header->number = OWORD_NONE;
+  }
+}
+
+
+// Returns the slot of a stored subroutine, or N_OWORD_SUB if none.
+static uint8_t oword_find_slot(uint16_t number, oword_header_t *header)
+{
+  uint8_t slot;
+  for (slot=0; slot<N_OWORD_SUB; slot++) {
+    oword_read_header(slot, header);
+    if (header->number == number) { break; }
+  }
+  return(slot);
+}
+
+
+void oword_restore()
+{
+  oword_header_t header;
+  memset(&header, 0, sizeof(oword_header_t));
+  uint8_t slot;
+  for (slot=0; slot<N_OWORD_SUB; slot++) {
+    memcpy_to_eeprom_with_checksum(OWORD_SLOT_ADDR(slot), (char*)&header, sizeof(oword_header_t));
+  }
+}
+
+
+// Matches one of the names of a table at the line position, and moves past it. Returns its index,
+// or the table count if none matches.
+static uint8_t oword_match(char *line, uint8_t *char_counter, const __flash char *table, uint8_t count, uint8_t size)
+{
+  uint8_t match, idx;
+  for (match=0; match<count; match++) {
+    idx = 0;
+    while (table[idx] && (table[idx] == line[*char_counter+idx])) { idx++; }
+    if (table[idx] == 0) {
+      *char_counter += idx;
+      break;
+    }
+    table += size;
+  }
+  return(match);
+}
+
+
+// Returns the storage of a parameter that can be set, or NULL if it is unknown or read-only.
+static float *oword_get_settable_parameter(uint16_t number)
+{
+  if ((number >= 1) && (number <= OWORD_MAX_PARAMETERS)) {
+    return(&oword_frame[oword_depth].parameter[number-1]);
+  }
+  if ((number >= OWORD_PARAM_GLOBAL) && (number < OWORD_PARAM_GLOBAL+OWORD_GLOBAL_PARAMETERS)) {
+    return(&oword_global[number-OWORD_PARAM_GLOBAL]);
+  }
+  return(NULL);
+}
+
+
+static uint8_t oword_get_parameter(uint16_t number, float *float_ptr)
+{
+  float *parameter = oword_get_settable_parameter(number);
+  if (parameter != NULL) {
+    *float_ptr = *parameter;
+    return(true);
+  }
+  if (number == OWORD_PARAM_PROBE_SUCCEEDED) {
+    *float_ptr = sys.probe_succeeded;
+    return(true);
+  }
+  if (number == OWORD_PARAM_COORD_SELECT) {
+    *float_ptr = gc_state.modal.coord_select+1;
+    #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+      // Numbered from 10, past the 7-9 that LinuxCNC gives G59.1-G59.3.
+      if (gc_state.modal.coord_select >= SETTING_INDEX_EXTENDED) {
+        *float_ptr = 9+gc_state.modal.coord_select-(SETTING_INDEX_EXTENDED-1);
+      }
+    #endif
+    return(true);
+  }
+
+  float axis_data[N_AXIS];
+  uint8_t idx;
+  uint8_t is_position = false;
+  if ((number >= OWORD_PARAM_PROBE) && (number < OWORD_PARAM_PROBE+N_AXIS)) {
+    idx = number-OWORD_PARAM_PROBE;
+    probe_get_position(axis_data);
+    mc_convert_to_program_position(axis_data); // Without the height map and transform compensations.
+    is_position = true;
+  } else if ((number >= OWORD_PARAM_G28) && (number < OWORD_PARAM_G28+N_AXIS)) {
+    idx = number-OWORD_PARAM_G28;
+    if (!settings_read_coord_data(SETTING_INDEX_G28, axis_data)) { return(false); }
+  } else if ((number >= OWORD_PARAM_G30) && (number < OWORD_PARAM_G30+N_AXIS)) {
+    idx = number-OWORD_PARAM_G30;
+    if (!settings_read_coord_data(SETTING_INDEX_G30, axis_data)) { return(false); }
+  } else if ((number >= OWORD_PARAM_G92) && (number < OWORD_PARAM_G92+N_AXIS)) {
+    idx = number-OWORD_PARAM_G92;
+    memcpy(axis_data, gc_state.coord_offset, sizeof(axis_data));
+  } else if ((number >= OWORD_PARAM_G54) && (number < OWORD_PARAM_G54+N_COORDINATE_SYSTEM*OWORD_PARAM_G54_SPACING)) {
+    idx = (number-OWORD_PARAM_G54) % OWORD_PARAM_G54_SPACING;
+    if (idx >= N_AXIS) { return(false); }
+    if (!settings_read_coord_data((number-OWORD_PARAM_G54)/OWORD_PARAM_G54_SPACING, axis_data)) { return(false); }
+  } else if ((number >= OWORD_PARAM_POSITION) && (number < OWORD_PARAM_POSITION+N_AXIS)) {
+    idx = number-OWORD_PARAM_POSITION;
+    memcpy(axis_data, gc_state.position, sizeof(axis_data));
+    is_position = true;
+  } else {
+    return(false);
+  }
+
+  float value = axis_data[idx];
+  if (is_position) { // Machine to work coordinates, as the reported work position.
+    value -= gc_state.coord_system[idx]+gc_state.coord_offset[idx];
+    if (idx == TOOL_LENGTH_OFFSET_AXIS) { value -= gc_state.tool_length_offset; }
+  }
+  if ((idx < N_AXIS_LINEAR) && (gc_state.modal.units == UNITS_MODE_INCHES)) { value /= MM_PER_INCH; }
+  *float_ptr = value;
+  return(true);
+}
+
+
+static uint8_t oword_read_value(char *line, uint8_t *char_counter, float *float_ptr);
+
+// Reads the number of a #n parameter, past its '#'. The number may itself be a value, as in #[30+#1].
+static uint8_t oword_read_parameter_number(char *line, uint8_t *char_counter, uint16_t *number)
+{
+  float value;
+  (*char_counter)++;
+  if (!oword_read_value(line, char_counter, &value)) { return(false); }
+  if ((value < 1.0) || (value > 65535.0) || (value != trunc(value))) { return(false); }
+  *number = value;
+  return(true);
+}
+
+
+static uint8_t oword_apply_function(uint8_t function, float *float_ptr)
+{
+  float value = *float_ptr;
+  switch (function) {
+    case OWORD_FN_ABS: value = fabs(value); break;
+    case OWORD_FN_ACOS:
+      if (fabs(value) > 1.0) { return(false); }
+      value = acos(value)*(180.0/M_PI); break;
+    case OWORD_FN_ASIN:
+      if (fabs(value) > 1.0) { return(false); }
+      value = asin(value)*(180.0/M_PI); break;
+    case OWORD_FN_COS: value = cos(value*(M_PI/180.0)); break;
+    case OWORD_FN_EXP: value = exp(value); break;
+    case OWORD_FN_FIX: value = floor(value); break;
+    case OWORD_FN_FUP: value = ceil(value); break;
+    case OWORD_FN_LN:
+      if (value <= 0.0) { return(false); }
+      value = log(value); break;
+    case OWORD_FN_ROUND: value = round(value); break;
+    case OWORD_FN_SIN: value = sin(value*(M_PI/180.0)); break;
+    case OWORD_FN_SQRT:
+      if (value < 0.0) { return(false); }
+      value = sqrt(value); break;
+    case OWORD_FN_TAN: value = tan(value*(M_PI/180.0)); break;
+  }
+  *float_ptr = value;
+  return(true);
+}
+
+
+static uint8_t oword_precedence(uint8_t op)
+{
+  if (op == OWORD_OP_POWER) { return(5); }
+  if (op <= OWORD_OP_MODULO) { return(4); }
+  if (op <= OWORD_OP_SUBTRACT) { return(3); }
+  if (op <= OWORD_OP_LE) { return(2); }
+  return(1); // Logical operators
+}
+
+
+static uint8_t oword_apply_operator(uint8_t op, float *float_ptr, float rhs)
+{
+  float value = *float_ptr;
+  switch (op) {
+    case OWORD_OP_POWER: value = pow(value, rhs); break;
+    case OWORD_OP_MULTIPLY: value *= rhs; break;
+    case OWORD_OP_DIVIDE:
+      if (rhs == 0.0) { return(false); }
+      value /= rhs; break;
+    case OWORD_OP_MODULO:
+      if (rhs == 0.0) { return(false); }
+      value = fmod(value, rhs);
+      if (value < 0.0) { value += fabs(rhs); } // Result is never negative.
+      break;
+    case OWORD_OP_ADD: value += rhs; break;
+    case OWORD_OP_SUBTRACT: value -= rhs; break;
+    case OWORD_OP_EQ: value = (value == rhs); break;
+    case OWORD_OP_NE: value = (value != rhs); break;
+    case OWORD_OP_GT: value = (value > rhs); break;
+    case OWORD_OP_GE: value = (value >= rhs); break;
+    case OWORD_OP_LT: value = (value < rhs); break;
+    case OWORD_OP_LE: value = (value <= rhs); break;
+    case OWORD_OP_AND: value = ((value != 0.0) && (rhs != 0.0)); break;
+    case OWORD_OP_OR: value = ((value != 0.0) || (rhs != 0.0)); break;
+    case OWORD_OP_XOR: value = ((value != 0.0) != (rhs != 0.0)); break;
+  }
+  *float_ptr = value;
+  return(true);
+}
+
+
+static uint8_t oword_read_expression(char *line, uint8_t *char_counter, float *float_ptr, uint8_t precedence);
+
+// Reads a value. That is a number, a #n parameter, a bracketed expression, a function of a bracketed
+// expression, or any of these with a leading sign.
+static uint8_t oword_read_value(char *line, uint8_t *char_counter, float *float_ptr)
+{
+  char c = line[*char_counter];
+  if (c == '#') {
+    uint16_t number;
+    if (!oword_read_parameter_number(line, char_counter, &number)) { return(false); }
+    return(oword_get_parameter(number, float_ptr));
+  }
+  if (c == '[') {
+    (*char_counter)++;
+    if (!oword_read_expression(line, char_counter, float_ptr, 0)) { return(false); }
+    if (line[*char_counter] != ']') { return(false); }
+    (*char_counter)++;
+    return(true);
+  }
+  if ((c == '-') || (c == '+')) {
+    (*char_counter)++;
+    if (!oword_read_value(line, char_counter, float_ptr)) { return(false); }
+    if (c == '-') { *float_ptr = -(*float_ptr); }
+    return(true);
+  }
+  if ((c >= 'A') && (c <= 'Z')) {
+    uint8_t function = oword_match(line, char_counter, &oword_function[0][0], N_OWORD_FN, sizeof(oword_function[0]));
+    if ((function == N_OWORD_FN) || (line[*char_counter] != '[')) { return(false); }
+    if (!oword_read_value(line, char_counter, float_ptr)) { return(false); }
+    return(oword_apply_function(function, float_ptr));
+  }
+  return(read_float(line, char_counter, float_ptr));
+}
+
+
+// Reads an expression of values and binary operators, up to the first operator of the given or
+// lower precedence. Called with zero precedence to read a whole expression. Operators of equal
+// precedence are evaluated from left to right. Comparisons and logical operators return 1 or 0.
+static uint8_t oword_read_expression(char *line, uint8_t *char_counter, float *float_ptr, uint8_t precedence)
+{
+  if (!oword_read_value(line, char_counter, float_ptr)) { return(false); }
+  uint8_t next_counter, op;
+  float rhs;
+  for (;;) {
+    next_counter = *char_counter;
+    op = oword_match(line, &next_counter, &oword_operator[0][0], N_OWORD_OP, sizeof(oword_operator[0]));
+    if ((op == N_OWORD_OP) || (oword_precedence(op) <= precedence)) { return(true); }
+    *char_counter = next_counter;
+    if (!oword_read_expression(line, char_counter, &rhs, oword_precedence(op))) { return(false); }
+    if (!oword_apply_operator(op, float_ptr, rhs)) { return(false); }
+  }
+}
+
+
+uint8_t oword_read_word_value(char *line, uint8_t *char_counter, float *float_ptr, int32_t *int_ptr, uint8_t *mantissa_ptr)
+{
+  char c = line[*char_counter];
+  if ((c == '-') || (c == '+')) { c = line[*char_counter+1]; } // As in X-#1
+  if ((c != '#') && (c != '[')) {
+    return(read_float_fixed(line, char_counter, float_ptr, int_ptr, mantissa_ptr));
+  }
+  if (!oword_read_value(line, char_counter, float_ptr)) { return(false); }
+
+  // Derive the integer part and mantissa from the value, as read_float_fixed() does from its digits.
+  float value = fabs(*float_ptr);
+  int32_t int_part = 0x7FFFFFFF;
+  if (value < 2147483647.0) { int_part = trunc(value); }
+  *mantissa_ptr = round(100*(value-int_part));
+  if (*float_ptr < 0.0) { int_part = -int_part; }
+  *int_ptr = int_part;
+  return(true);
+}
+
+
+// Parses the o-word number and keyword of a line starting with 'O'. Returns the keyword, or
+// OWORD_KEYWORD_NONE if the line is not an o-word command.
+static uint8_t oword_parse_command(char *line, uint8_t *char_counter, uint16_t *number)
+{
+  float value;
+  int32_t int_part;
+  uint8_t mantissa;
+  *char_counter = 1;
+  if (!read_float_fixed(line, char_counter, &value, &int_part, &mantissa)) { return(OWORD_KEYWORD_NONE); }
+  if ((mantissa != 0) || (int_part < 1) || (int_part > 0xFFFF)) { return(OWORD_KEYWORD_NONE); }
+  *number = int_part;
+  return(oword_match(line, char_counter, &oword_keyword[0][0], N_OWORD_KEYWORD, sizeof(oword_keyword[0])));
+}
+
+
+static uint8_t oword_begin_definition(uint16_t number)
+{
+  if (oword_depth) { return(STATUS_OWORD_INVALID_COMMAND); } // Not from a running subroutine.
+
+  // Redefine a stored subroutine in place. Otherwise, take the first free slot.
+  oword_header_t header;
+  uint8_t slot = oword_find_slot(number, &header);
+  if (slot == N_OWORD_SUB) { slot = oword_find_slot(OWORD_NONE, &header); }
+
+  // Without a slot, still take in the lines up to ENDSUB, so none of them is executed instead.
+  oword_define.number = number;
+  oword_define.length = 0;
+  oword_define.checksum = 0;
+  if (slot == N_OWORD_SUB) {
+    oword_define.status = STATUS_OWORD_STORAGE_FULL;
+    return(STATUS_OWORD_STORAGE_FULL);
+  }
+  oword_define.status = STATUS_OK;
+
+  // EEPROM writes hold off all interrupts, including the stepper. Let buffered motions finish first.
+  protocol_buffer_synchronize();
+  if (sys.abort) { return(STATUS_OK); }
+
+  // Free the slot until the definition ends, so an interrupted definition is never called.
+  memset(&header, 0, sizeof(oword_header_t));
+  oword_define.addr = OWORD_SLOT_ADDR(slot);
+  memcpy_to_eeprom_with_checksum(oword_define.addr, (char*)&header, sizeof(oword_header_t));
+  return(STATUS_OK);
+}
+
+
+static uint8_t oword_store_line(char *line)
+{
+  if (oword_define.status == STATUS_OK) {
+    uint16_t length = strlen(line)+1;
+    if (length > EEPROM_LINE_SIZE) {
+      oword_define.status = STATUS_LINE_LENGTH_EXCEEDED;
+    } else if (oword_define.length+length > OWORD_BODY_SIZE) {
+      oword_define.status = STATUS_OWORD_STORAGE_FULL;
+    } else {
+      uint16_t addr = oword_define.addr+sizeof(oword_header_t)+1+oword_define.length;
+      oword_define.length += length;
+      do {
+        eeprom_put_char(addr++, *line);
+        oword_define.checksum = oword_checksum(oword_define.checksum, *line);
+      } while (*line++);
+    }
+  }
+  return(oword_define.status);
+}
+
+
+static uint8_t oword_end_definition()
+{
+  uint8_t status = oword_define.status;
+  if (status == STATUS_OK) {
+    oword_header_t header;
+    header.number = oword_define.number;
+    header.length = oword_define.length;
+    header.checksum = oword_define.checksum;
+    memcpy_to_eeprom_with_checksum(oword_define.addr, (char*)&header, sizeof(oword_header_t));
+  }
+  oword_define.number = OWORD_NONE;
+  return(status);
+}
+
+
+// Reads the next body line of the running subroutine.
+static void oword_read_line(oword_frame_t *frame, char *line)
+{
+  do { *line = eeprom_get_char(frame->addr+frame->pc++); } while (*line++);
+}
+
+
+// Executes the lines of the called subroutines, until the outermost call returns. A call from a
+// subroutine only pushes its frame, so nested calls run from this same loop without recursion.
+static uint8_t oword_run()
+{
+  char line[EEPROM_LINE_SIZE];
+  oword_frame_t *frame;
+  uint8_t status = STATUS_OK;
+  while (oword_depth) {
+    protocol_execute_realtime(); // Runtime command check point.
+    if (sys.abort) { break; }
+    if (sys.state == STATE_ALARM) { status = STATUS_SYSTEM_GC_LOCK; } // Probe failure or similar.
+    else {
+      frame = &oword_frame[oword_depth];
+      if (frame->pc >= frame->length) { // End of body. Return to caller and drop its repeat loops.
+        oword_depth--;
+        while (oword_repeat_depth && (oword_repeat[oword_repeat_depth-1].depth > oword_depth)) { oword_repeat_depth--; }
+        continue;
+      }
+      oword_read_line(frame, line);
+      status = gc_execute_line(line);
+    }
+    if (status != STATUS_OK) { break; }
+  }
+  oword_depth = 0;
+  oword_repeat_depth = 0;
+  return(status);
+}
+
+
+static uint8_t oword_call(char *line, uint8_t char_counter, uint16_t number)
+{
+  if (oword_depth == OWORD_MAX_CALL_DEPTH) { return(STATUS_OWORD_CALL_DEPTH_EXCEEDED); }
+
+  // Read the bracketed call arguments. Unset arguments are zero.
+  oword_frame_t *frame = &oword_frame[oword_depth+1];
+  memset(frame->parameter, 0, sizeof(frame->parameter));
+  uint8_t idx = 0;
+  while (line[char_counter] != 0) {
+    if ((line[char_counter] != '[') || (idx == OWORD_MAX_PARAMETERS)) { return(STATUS_OWORD_INVALID_COMMAND); }
+    if (!oword_read_value(line, &char_counter, &frame->parameter[idx++])) { return(STATUS_BAD_NUMBER_FORMAT); }
+  }
+
+  oword_header_t header;
+  uint8_t slot = oword_find_slot(number, &header);
+  if (slot == N_OWORD_SUB) { return(STATUS_OWORD_UNDEFINED_SUB); }
+  frame->number = number;
+  frame->addr = OWORD_SLOT_ADDR(slot)+sizeof(oword_header_t)+1;
+  frame->length = header.length;
+  frame->pc = 0;
+
+  // Verify the whole body before running any of it.
+  uint8_t checksum = 0;
+  uint16_t pc;
+  for (pc=0; pc<frame->length; pc++) { checksum = oword_checksum(checksum, eeprom_get_char(frame->addr+pc)); }
+  if (checksum != header.checksum) { return(STATUS_SETTING_READ_FAIL); }
+
+  oword_depth++;
+  if (oword_depth > 1) { return(STATUS_OK); } // Called from a subroutine. Already running.
+  return(oword_run());
+}
+
+
+// Sets the parameters of a '#<n>=<value>' line. The assignments of a line are made in order.
+static uint8_t oword_assign(char *line)
+{
+  uint8_t char_counter = 0;
+  uint16_t number;
+  float *parameter;
+  while (line[char_counter] != 0) {
+    if (line[char_counter] != '#') { return(STATUS_BAD_NUMBER_FORMAT); }
+    if (!oword_read_parameter_number(line, &char_counter, &number)) { return(STATUS_BAD_NUMBER_FORMAT); }
+    parameter = oword_get_settable_parameter(number);
+    if (parameter == NULL) { return(STATUS_OWORD_INVALID_PARAMETER); }
+    if (line[char_counter++] != '=') { return(STATUS_BAD_NUMBER_FORMAT); }
+    if (!oword_read_value(line, &char_counter, parameter)) { return(STATUS_BAD_NUMBER_FORMAT); }
+  }
+  return(STATUS_OK);
+}
+
+
+// Moves the running subroutine past the next O<number> line with one of the keywords in the mask,
+// searching from the given body offset. The found line is left in line, with char_counter past
+// its keyword. Returns the keyword, or OWORD_KEYWORD_NONE if there is no such line.
+// NOTE: As blocks are found by their o-word number, nested blocks must have different numbers.
+static uint8_t oword_seek(uint16_t pc, uint16_t number, uint16_t keyword_mask, char *line, uint8_t *char_counter)
+{
+  oword_frame_t *frame = &oword_frame[oword_depth];
+  uint16_t line_number;
+  uint8_t keyword;
+  frame->pc = pc;
+  while (frame->pc < frame->length) {
+    oword_read_line(frame, line);
+    if (line[0] != 'O') { continue; }
+    keyword = oword_parse_command(line, char_counter, &line_number);
+    if ((keyword != OWORD_KEYWORD_NONE) && (line_number == number) && (keyword_mask & bit(keyword))) { return(keyword); }
+  }
+  return(OWORD_KEYWORD_NONE);
+}
+
+
+// Reads the bracketed condition, or repeat count, ending an o-word line.
+static uint8_t oword_read_condition(char *line, uint8_t char_counter, float *value)
+{
+  if (line[char_counter] != '[') { return(STATUS_OWORD_INVALID_COMMAND); }
+  if (!oword_read_value(line, &char_counter, value)) { return(STATUS_BAD_NUMBER_FORMAT); }
+  if (line[char_counter] != 0) { return(STATUS_OWORD_INVALID_COMMAND); }
+  return(STATUS_OK);
+}
+
+
+// Enters a while loop, or ends it at its ENDWHILE line when the condition is false.
+static uint8_t oword_while(char *line, uint8_t char_counter, uint16_t number)
+{
+  float value;
+  uint8_t status = oword_read_condition(line, char_counter, &value);
+  if (status != STATUS_OK) { return(status); }
+  if (value == 0.0) {
+    if (oword_seek(oword_frame[oword_depth].pc, number, bit(OWORD_KEYWORD_ENDWHILE), line, &char_counter) == OWORD_KEYWORD_NONE) {
+      return(STATUS_OWORD_INVALID_COMMAND);
+    }
+  }
+  return(STATUS_OK);
+}
+
+
+// Goes back to the WHILE line of a loop and evaluates its condition again.
+static uint8_t oword_endwhile(char *line, uint16_t number)
+{
+  uint8_t char_counter;
+  if (oword_seek(0, number, bit(OWORD_KEYWORD_WHILE), line, &char_counter) == OWORD_KEYWORD_NONE) {
+    return(STATUS_OWORD_INVALID_COMMAND);
+  }
+  return(oword_while(line, char_counter, number));
+}
+
+
+static uint8_t oword_repeat_loop(char *line, uint8_t char_counter, uint16_t number)
+{
+  float value;
+  uint8_t status = oword_read_condition(line, char_counter, &value);
+  if (status != STATUS_OK) { return(status); }
+  value = trunc(value);
+  if (value < 1.0) { // Skip the loop.
+    if (oword_seek(oword_frame[oword_depth].pc, number, bit(OWORD_KEYWORD_ENDREPEAT), line, &char_counter) == OWORD_KEYWORD_NONE) {
+      return(STATUS_OWORD_INVALID_COMMAND);
+    }
+    return(STATUS_OK);
+  }
+  if (oword_repeat_depth == OWORD_MAX_REPEAT_DEPTH) { return(STATUS_OWORD_CALL_DEPTH_EXCEEDED); }
+  oword_repeat_t *repeat = &oword_repeat[oword_repeat_depth++];
+  repeat->number = number;
+  repeat->depth = oword_depth;
+  repeat->pc = oword_frame[oword_depth].pc;
+  repeat->count = (value < 4294967295.0) ? value : 0xFFFFFFFF;
+  return(STATUS_OK);
+}
+
+
+// Returns the innermost repeat loop, if it is the given loop of the running subroutine. Otherwise, NULL.
+static oword_repeat_t *oword_get_repeat(uint16_t number)
+{
+  if (!oword_repeat_depth) { return(NULL); }
+  oword_repeat_t *repeat = &oword_repeat[oword_repeat_depth-1];
+  if ((repeat->number != number) || (repeat->depth != oword_depth)) { return(NULL); }
+  return(repeat);
+}
+
+
+static uint8_t oword_endrepeat(uint16_t number)
+{
+  oword_repeat_t *repeat = oword_get_repeat(number);
+  if (repeat == NULL) { return(STATUS_OWORD_INVALID_COMMAND); }
+  if (--(repeat->count)) { oword_frame[oword_depth].pc = repeat->pc; }
+  else { oword_repeat_depth--; }
+  return(STATUS_OK);
+}
+
+
+// Leaves a while or repeat loop, or goes on with its next iteration.
+static uint8_t oword_break(char *line, uint16_t number, uint8_t keyword)
+{
+  uint8_t char_counter;
+  uint8_t end_keyword = oword_seek(oword_frame[oword_depth].pc, number,
+                                   (bit(OWORD_KEYWORD_ENDWHILE)|bit(OWORD_KEYWORD_ENDREPEAT)), line, &char_counter);
+  if (end_keyword == OWORD_KEYWORD_NONE) { return(STATUS_OWORD_INVALID_COMMAND); }
+  if (end_keyword == OWORD_KEYWORD_ENDWHILE) {
+    if (keyword == OWORD_KEYWORD_CONTINUE) { return(oword_endwhile(line, number)); }
+    return(STATUS_OK);
+  }
+  if (keyword == OWORD_KEYWORD_CONTINUE) { return(oword_endrepeat(number)); }
+  if (oword_get_repeat(number) == NULL) { return(STATUS_OWORD_INVALID_COMMAND); }
+  oword_repeat_depth--; // Drop the remaining repeats.
+  return(STATUS_OK);
+}
+
+
+// Runs the branch of an IF line if its condition is true. Otherwise, skips to the next ELSEIF with a
+// true condition, the ELSE line, or the ENDIF line.
+static uint8_t oword_if(char *line, uint8_t char_counter, uint16_t number)
+{
+  float value;
+  uint8_t status, keyword;
+  for (;;) {
+    status = oword_read_condition(line, char_counter, &value);
+    if ((status != STATUS_OK) || (value != 0.0)) { return(status); }
+    keyword = oword_seek(oword_frame[oword_depth].pc, number,
+                         (bit(OWORD_KEYWORD_ELSEIF)|bit(OWORD_KEYWORD_ELSE)|bit(OWORD_KEYWORD_ENDIF)), line, &char_counter);
+    if (keyword == OWORD_KEYWORD_NONE) { return(STATUS_OWORD_INVALID_COMMAND); }
+    if (keyword != OWORD_KEYWORD_ELSEIF) { return(STATUS_OK); }
+  }
+}
+
+
+uint8_t oword_execute_line(char *line)
+{
+  uint8_t char_counter = 0;
+  uint16_t number = OWORD_NONE;
+  uint8_t keyword = OWORD_KEYWORD_NONE;
+  if (line[0] == 'O') { keyword = oword_parse_command(line, &char_counter, &number); }
+
+  // Store all lines of a definition, up to its own ENDSUB line.
+  if (oword_define.number != OWORD_NONE) {
+    if ((keyword == OWORD_KEYWORD_ENDSUB) && (number == oword_define.number) && (line[char_counter] == 0)) {
+      return(oword_end_definition());
+    }
+    return(oword_store_line(line));
+  }
+  if (line[0] == '#') { return(oword_assign(line)); }
+
+  switch (keyword) {
+    case OWORD_KEYWORD_SUB:
+      if (line[char_counter] == 0) { return(oword_begin_definition(number)); }
+      break;
+    case OWORD_KEYWORD_CALL:
+      return(oword_call(line, char_counter, number));
+    case OWORD_KEYWORD_RETURN:
+      if ((line[char_counter] == 0) && oword_depth && (number == oword_frame[oword_depth].number)) {
+        oword_frame[oword_depth].pc = oword_frame[oword_depth].length;
+        return(STATUS_OK);
+      }
+      break;
+    case OWORD_KEYWORD_NONE: case OWORD_KEYWORD_ENDSUB:
+      break;
+    default:
+      // Control flow jumps within the stored body, so it only runs from a called subroutine.
+      if (!oword_depth) { break; }
+      switch (keyword) {
+        case OWORD_KEYWORD_WHILE: return(oword_while(line, char_counter, number));
+        case OWORD_KEYWORD_REPEAT: return(oword_repeat_loop(line, char_counter, number));
+        case OWORD_KEYWORD_IF: return(oword_if(line, char_counter, number));
+        case OWORD_KEYWORD_ELSEIF: // End of the branch that ran. The condition is not evaluated.
+          if (oword_seek(oword_frame[oword_depth].pc, number, bit(OWORD_KEYWORD_ENDIF), line, &char_counter) != OWORD_KEYWORD_NONE) {
+            return(STATUS_OK);
+          }
+          return(STATUS_OWORD_INVALID_COMMAND);
+      }
+      if (line[char_counter] != 0) { break; }
+      switch (keyword) {
+        case OWORD_KEYWORD_ENDWHILE: return(oword_endwhile(line, number));
+        case OWORD_KEYWORD_ENDREPEAT: return(oword_endrepeat(number));
+        case OWORD_KEYWORD_BREAK: case OWORD_KEYWORD_CONTINUE: return(oword_break(line, number, keyword));
+        case OWORD_KEYWORD_ELSE: // End of the branch that ran.
+          if (oword_seek(oword_frame[oword_depth].pc, number, bit(OWORD_KEYWORD_ENDIF), line, &char_counter) != OWORD_KEYWORD_NONE) {
+            return(STATUS_OK);
+          }
+          break;
+        case OWORD_KEYWORD_ENDIF: return(STATUS_OK);
+      }
+  }
+  return(STATUS_OWORD_INVALID_COMMAND);
+}
+
+#endif
@@ -0,0 +1,57 @@
+/*
+  oword.h - o-word subroutines stored in EEPROM
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef oword_h
+#define oword_h
+
+#ifndef OWORD_MAX_CALL_DEPTH
+  #define OWORD_MAX_CALL_DEPTH 3
+#endif
+#ifndef OWORD_MAX_PARAMETERS
+  #define OWORD_MAX_PARAMETERS 8
+#endif
+#ifndef OWORD_MAX_REPEAT_DEPTH
+  #define OWORD_MAX_REPEAT_DEPTH 4
+#endif
+#ifndef OWORD_GLOBAL_PARAMETERS
+  #define OWORD_GLOBAL_PARAMETERS 20
+#endif
+#if OWORD_MAX_PARAMETERS > 30
+  #error "OWORD_MAX_PARAMETERS must not overlap the global parameters, which start at #31."
+#endif
+
+// Initialize the o-word state. Ends any subroutine definition or call. Called upon every reset.
+void oword_init();
+
+// Returns true while the lines of a subroutine are being stored, instead of executed.
+uint8_t oword_is_defining();
+
+// Executes an o-word or parameter assignment line, or stores the line while a subroutine is being
+// defined.
+uint8_t oword_execute_line(char *line);
+
+// Reads a g-code word value, which may also be a #n parameter or a bracketed expression. Otherwise,
+// same as read_float_fixed().
+uint8_t oword_read_word_value(char *line, uint8_t *char_counter, float *float_ptr, int32_t *int_ptr, uint8_t *mantissa_ptr);
+
+// Erases all stored subroutines.
+void oword_restore();
+
+#endif
@@ -247,6 +247,13 @@ float plan_get_exec_block_exit_speed_sqr()
 }
 
 
+void plan_get_planner_mpos(float *target)
+{
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) { target[idx] = pl.position[idx]/settings.steps_per_mm[idx]; }
+}
+
+
 // Returns the availability status of the block ring buffer. True, if full.
 uint8_t plan_check_full_buffer()
 {
@@ -318,7 +325,7 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
   // Prepare and initialize new block. Copy relevant pl_data for block execution.
   plan_block_t *block = &block_buffer[block_buffer_head];
   memset(block,0,sizeof(plan_block_t)); // Zero all block values.
-  block->condition = pl_data->condition;
+  block->condition = (uint8_t)pl_data->condition; // Flags past bit 7 only apply before planning.
   block->spindle_speed = pl_data->spindle_speed;
   block->line_number = pl_data->line_number;
 
@@ -450,9 +457,20 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
       } else {
         convert_delta_vector_to_unit_vector(junction_unit_vec);
         float junction_acceleration = limit_value_by_axis_maximum(settings.acceleration, junction_unit_vec);
-        float sin_theta_d2 = sqrt(0.5*(1.0-junction_cos_theta)); // Trig half angle identity. Always positive.
-        block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
-                       (junction_acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+        #ifdef ARC_CURVATURE_JUNCTION_SPEED
+          // Between two segments of an arc, the junction vector points to the arc center. So the
+          // centripetal acceleration about the arc radius itself applies, v^2 = a*r. A helix or any
+          // linear axis travel only makes the path radius larger, so this is on the safe side.
+          if (pl_data->arc_radius > 0.0) {
+            block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                           junction_acceleration * pl_data->arc_radius );
+          } else
+        #endif
+        {
+          float sin_theta_d2 = sqrt(0.5*(1.0-junction_cos_theta)); // Trig half angle identity. Always positive.
+          block->max_junction_speed_sqr = max( MINIMUM_JUNCTION_SPEED*MINIMUM_JUNCTION_SPEED,
+                         (junction_acceleration * settings.junction_deviation * sin_theta_d2)/(1.0-sin_theta_d2) );
+        }
       }
     }
   }
@@ -508,6 +526,33 @@ uint8_t plan_get_block_buffer_available()
 }
 
 
+// Returns the total remaining distance of all blocks in the planner buffer in (mm).
+float plan_get_buffered_millimeters()
+{
+  float millimeters = 0.0;
+  uint8_t block_index = block_buffer_tail;
+  while (block_index != block_buffer_head) {
+    millimeters += block_buffer[block_index].millimeters;
+    block_index = plan_next_block_index(block_index);
+  }
+  return(millimeters);
+}
+
+
+// Returns the nominal execution time of all blocks in the planner buffer in (min). Acceleration
+// and overrides are not accounted for. Used as an estimate of how long the buffer can run.
+float plan_get_buffered_time()
+{
+  float minutes = 0.0;
+  uint8_t block_index = block_buffer_tail;
+  while (block_index != block_buffer_head) {
+    minutes += block_buffer[block_index].millimeters/block_buffer[block_index].programmed_rate;
+    block_index = plan_next_block_index(block_index);
+  }
+  return(minutes);
+}
+
+
 // Returns the number of active blocks are in the planner buffer.
 // NOTE: Deprecated. Not used unless classic status reports are enabled in config.h
 uint8_t plan_get_block_buffer_count()
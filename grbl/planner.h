@@ -42,6 +42,8 @@
 #define PL_COND_FLAG_SPINDLE_CCW       bit(5)
 #define PL_COND_FLAG_COOLANT_FLOOD     bit(6)
 #define PL_COND_FLAG_COOLANT_MIST      bit(7)
+#define PL_COND_FLAG_MACHINE_COORD     bit(8) // Machine coordinate motion (G53). Not compensated. Not stored in blocks.
+#define PL_COND_FLAG_JOG               bit(9) // Jog motion. Queued as a single line. Not stored in blocks.
 #define PL_COND_MOTION_MASK    (PL_COND_FLAG_RAPID_MOTION|PL_COND_FLAG_SYSTEM_MOTION|PL_COND_FLAG_NO_FEED_OVERRIDE)
 #define PL_COND_SPINDLE_MASK   (PL_COND_FLAG_SPINDLE_CW|PL_COND_FLAG_SPINDLE_CCW)
 #define PL_COND_ACCESSORY_MASK (PL_COND_FLAG_SPINDLE_CW|PL_COND_FLAG_SPINDLE_CCW|PL_COND_FLAG_COOLANT_FLOOD|PL_COND_FLAG_COOLANT_MIST)
@@ -89,7 +91,10 @@ typedef struct {
     float output_volts;   // Desired output PWM value for line motion. Value is ignored, if rapid motion.
   #endif
   int32_t line_number;    // Desired line number to report when executing.
-  uint8_t condition;      // Bitflag variable to indicate planner conditions. See defines above.
+  uint16_t condition;     // Bitflag variable to indicate planner conditions. See defines above.
+  #ifdef ARC_CURVATURE_JUNCTION_SPEED
+    float arc_radius;     // Arc radius, when the line continues the arc of the prior line. Zero otherwise.
+  #endif
 } plan_line_data_t;
 
 
@@ -133,6 +138,12 @@ void plan_cycle_reinitialize();
 // Returns the number of available blocks are in the planner buffer.
 uint8_t plan_get_block_buffer_available();
 
+// Returns the total remaining distance of all blocks in the planner buffer in (mm).
+float plan_get_buffered_millimeters();
+
+// Returns the nominal execution time of all blocks in the planner buffer in (min).
+float plan_get_buffered_time();
+
 // Returns the number of active blocks are in the planner buffer.
 // NOTE: Deprecated. Not used unless classic status reports are enabled in config.h
 uint8_t plan_get_block_buffer_count();
@@ -140,6 +151,7 @@ uint8_t plan_get_block_buffer_count();
 // Returns the status of the block ring buffer. True, if buffer is full.
 uint8_t plan_check_full_buffer();
 
+// Returns the planner position, the end of the last queued motion, in machine coordinates.
 void plan_get_planner_mpos(float *target);
 
 
@@ -25,6 +25,25 @@
 // Inverts the probe pin state depending on user settings and probing cycle mode.
 uint8_t probe_invert_mask;
 
+#ifdef ENABLE_PROBE_CAPTURE
+  #ifdef INPUT_FILTERED_PROBE
+    #error "ENABLE_PROBE_CAPTURE requires INPUT_FILTER_PROBE to be INPUT_FILTER_NONE."
+  #endif
+
+  #define PROBE_CAPTURE_NONE   0 // No contact captured, or probe found by the stepper ISR tick only.
+  #define PROBE_CAPTURE_EDGE   1 // Contact timestamped. Waiting for the stepper ISR to record the position.
+  #define PROBE_CAPTURE_VALID  2 // Contact position recorded with its step rate.
+
+  // The probe contact, timestamped within a stepper ISR tick, and the step rate of that tick.
+  static volatile struct {
+    uint8_t state;
+    uint16_t time;   // Stepper timer count at the contact, from the start of the tick.
+    uint16_t period; // Stepper timer count of the whole tick.
+    uint32_t step_event_count;
+    int32_t steps[N_AXIS]; // Signed Bresenham increments per tick. Steps per tick are steps/step_event_count.
+  } probe_capture;
+#endif
+
 
 // Probe pin initialization routine.
 void probe_init()
@@ -36,6 +55,11 @@ void probe_init()
     PROBE_PORT |= PROBE_MASK;    // Enable internal pull-up resistors. Normal high operation.
   #endif
   probe_configure_invert_mask(false); // Initialize invert mask.
+  #ifdef ENABLE_PROBE_CAPTURE
+    probe_capture_reset();
+    PROBE_PCMSK |= PROBE_MASK; // Enable specific pins of the Pin Change Interrupt
+    PCICR |= (1 << PROBE_INT); // Enable Pin Change Interrupt
+  #endif
 }
 
 
@@ -51,7 +75,11 @@ void probe_configure_invert_mask(uint8_t is_probe_away)
 
 
 // Returns the probe pin state. Triggered = true. Called by gcode parser and probe state monitor.
-uint8_t probe_get_state() { return((PROBE_PIN & PROBE_MASK) ^ probe_invert_mask); }
+#ifdef INPUT_FILTERED_PROBE
+  uint8_t probe_get_state() { return(input_filter_probe ^ probe_invert_mask); }
+#else
+  uint8_t probe_get_state() { return((PROBE_PIN & PROBE_MASK) ^ probe_invert_mask); }
+#endif
 
 
 // Monitors probe pin state and records the system position when detected. Called by the
@@ -59,9 +87,112 @@ uint8_t probe_get_state() { return((PROBE_PIN & PROBE_MASK) ^ probe_invert_mask)
 // NOTE: This function must be extremely efficient as to not bog down the stepper ISR.
 void probe_state_monitor()
 {
+  #ifdef ENABLE_PROBE_CAPTURE
+    if (probe_capture.state == PROBE_CAPTURE_EDGE) {
+      // The contact was during the last tick, which ended with the step pulsed at the start of this
+      // interrupt. sys_position already counts that step. If the contact was during this interrupt
+      // instead, before any timer count of the next tick, then the step was out before the contact.
+      if (probe_capture.time <= TCNT1) { probe_capture.time = probe_capture.period; }
+      probe_capture.state = PROBE_CAPTURE_VALID;
+      sys_probe_state = PROBE_OFF;
+      memcpy(sys_probe_position, sys_position, sizeof(sys_position));
+      bit_true(sys_rt_exec_state, EXEC_MOTION_CANCEL);
+      return;
+    }
+  #endif
   if (probe_get_state()) {
     sys_probe_state = PROBE_OFF;
     memcpy(sys_probe_position, sys_position, sizeof(sys_position));
     bit_true(sys_rt_exec_state, EXEC_MOTION_CANCEL);
   }
 }
+
+
+void probe_get_position(float *position)
+{
+  system_convert_array_steps_to_mpos(position, sys_probe_position);
+  #ifdef ENABLE_PROBE_CAPTURE
+    if ((probe_capture.state == PROBE_CAPTURE_VALID) && probe_capture.step_event_count) {
+      // Steps moved within the tick until the contact, on each motor. The probe position counts the
+      // step that ends the tick, so the offset is taken back from it.
+      float fraction = ((float)probe_capture.time/probe_capture.period-1.0)/probe_capture.step_event_count;
+      float offset[N_AXIS];
+      uint8_t idx;
+      for (idx=0; idx<N_AXIS; idx++) { offset[idx] = fraction*probe_capture.steps[idx]; }
+      #ifdef COREXY
+        float offset_a = offset[A_MOTOR];
+        offset[A_MOTOR] = 0.5*(offset_a + offset[B_MOTOR]);
+        offset[B_MOTOR] = 0.5*(offset_a - offset[B_MOTOR]);
+      #endif
+      for (idx=0; idx<N_AXIS; idx++) { position[idx] += offset[idx]/settings.steps_per_mm[idx]; }
+    }
+  #endif
+}
+
+
+#ifdef ENABLE_PROBE_RESULT_BUFFER
+  #if (N_PROBE_RESULT < 1) || (N_PROBE_RESULT > 127)
+    #error "N_PROBE_RESULT must be between 1 and 127."
+  #endif
+
+  static probe_result_t probe_result[N_PROBE_RESULT];
+  static uint8_t probe_result_tail; // Index of the oldest result
+  static uint8_t probe_result_count;
+
+
+  void probe_store_result(int32_t line_number)
+  {
+    uint8_t index = probe_result_tail+probe_result_count;
+    if (index >= N_PROBE_RESULT) { index -= N_PROBE_RESULT; }
+    if (probe_result_count == N_PROBE_RESULT) {
+      if (++probe_result_tail == N_PROBE_RESULT) { probe_result_tail = 0; } // Overwrite the oldest.
+    } else {
+      probe_result_count++;
+    }
+    probe_get_position(probe_result[index].position);
+    probe_result[index].line_number = line_number;
+    probe_result[index].succeeded = sys.probe_succeeded;
+  }
+
+
+  uint8_t probe_read_result(uint8_t index, probe_result_t *result)
+  {
+    if (index >= probe_result_count) { return(false); }
+    index += probe_result_tail;
+    if (index >= N_PROBE_RESULT) { index -= N_PROBE_RESULT; }
+    memcpy(result, &probe_result[index], sizeof(probe_result_t));
+    return(true);
+  }
+
+
+  uint8_t probe_get_result_count() { return(probe_result_count); }
+
+
+  void probe_clear_results() { probe_result_tail = 0; probe_result_count = 0; }
+#endif
+
+
+#ifdef ENABLE_PROBE_CAPTURE
+  void probe_capture_reset() { probe_capture.state = PROBE_CAPTURE_NONE; }
+
+
+  // NOTE: The stepper timer counts from zero at each tick, so its count timestamps the contact within
+  // the tick. Only the first contact of a probing cycle is captured.
+  void probe_capture_edge()
+  {
+    if ((sys_probe_state == PROBE_ACTIVE) && (probe_capture.state == PROBE_CAPTURE_NONE)) {
+      if ((PROBE_PIN & PROBE_MASK) ^ probe_invert_mask) {
+        probe_capture.time = TCNT1;
+        probe_capture.period = OCR1A;
+        // The step rate and direction of this tick, before the stepper ISR loads another segment.
+        probe_capture.step_event_count = st_get_tick_rate((int32_t *)probe_capture.steps);
+        probe_capture.state = PROBE_CAPTURE_EDGE;
+      }
+    }
+  }
+
+
+  #if (PROBE_INT != CONTROL_INT) || defined(INPUT_FILTERED_CONTROL)
+    ISR(PROBE_INT_vect) { probe_capture_edge(); }
+  #endif // Otherwise, the control pin change interrupt calls probe_capture_edge().
+#endif
@@ -41,4 +41,37 @@ uint8_t probe_get_state();
 // stepper ISR per ISR tick.
 void probe_state_monitor();
 
+// Returns the last probe position in machine coordinates, interpolated between steps if captured
+// by the probe pin change interrupt.
+void probe_get_position(float *position);
+
+#ifdef ENABLE_PROBE_RESULT_BUFFER
+  typedef struct {
+    float position[N_AXIS]; // Probe position in machine coordinates.
+    int32_t line_number;    // Line number of the probing block.
+    uint8_t succeeded;      // Probe triggered within travel.
+  } probe_result_t;
+
+  // Records the last probe position and outcome in the result buffer, dropping the oldest result
+  // when full. Called at the end of a probing cycle.
+  void probe_store_result(int32_t line_number);
+
+  // Copies the result at index, oldest first. Returns false past the last stored result.
+  uint8_t probe_read_result(uint8_t index, probe_result_t *result);
+
+  // Returns the number of stored results.
+  uint8_t probe_get_result_count();
+
+  // Empties the result buffer.
+  void probe_clear_results();
+#endif
+
+#ifdef ENABLE_PROBE_CAPTURE
+  // Clears the captured probe contact. Called before a probing cycle starts.
+  void probe_capture_reset();
+
+  // Timestamps the probe contact while probing. Called by the probe pin change interrupt.
+  void probe_capture_edge();
+#endif
+
 #endif
@@ -30,7 +30,18 @@
 
 static char line[LINE_BUFFER_SIZE]; // Line to be executed. Zero-terminated.
 
+#ifdef ENABLE_PROGRAM_MODE
+  static uint8_t program_running; // True between a starting and an ending '%' line.
+#endif
+#if defined(ENABLE_PROGRAM_MODE) || defined(ENABLE_AUTO_CYCLE_START_POLICY)
+  static uint8_t cycle_start_pending; // True while buffered motions wait for the start policy.
+  static uint16_t cycle_start_pending_ms; // Tick time when motions began waiting.
+#endif
+
 static void protocol_exec_rt_suspend();
+#if defined(ENABLE_PROGRAM_MODE) || defined(ENABLE_AUTO_CYCLE_START_POLICY)
+  static void protocol_auto_cycle_start_buffered();
+#endif
 
 
 /*
@@ -72,6 +83,9 @@ void protocol_main_loop()
   uint8_t line_flags = 0;
   uint8_t char_counter = 0;
   uint8_t c;
+  #ifdef ENABLE_PROGRAM_MODE
+    program_running = false; // A reset always ends a running program.
+  #endif
   for (;;) {
 
     // Process one line of incoming serial data, as the data becomes available. Performs an
@@ -91,6 +105,16 @@ void protocol_main_loop()
         if (line_flags & LINE_FLAG_OVERFLOW) {
           // Report line overflow error.
           report_status_message(STATUS_OVERFLOW);
+        #ifdef ENABLE_PROGRAM_MODE
+          } else if ((line[0] == '%') && (line[1] == 0)) {
+            // Program start or end '%' line, once whitespace and comments are removed. A '%' anywhere
+            // else is passed to the g-code parser. Ending a program starts anything left in the buffer.
+            // NOTE: During a program, auto-cycle start waits for enough motion to be buffered,
+            // rather than starting on the first empty serial read buffer.
+            program_running = !program_running;
+            if (!program_running) { protocol_auto_cycle_start(); }
+            report_status_message(STATUS_OK);
+        #endif
         } else if (line[0] == 0) {
           // Empty or comment line. For syncing purposes.
           report_status_message(STATUS_OK);
@@ -109,6 +133,9 @@ void protocol_main_loop()
         line_flags = 0;
         char_counter = 0;
 
+        // Keep a canned cycle queuing while the host streams lines that queue no motion.
+        mc_generator_run();
+
       } else {
 
         if (line_flags) {
@@ -132,13 +159,6 @@ void protocol_main_loop()
           } else if (c == ';') {
             // NOTE: ';' comment to EOL is a LinuxCNC definition. Not NIST.
             line_flags |= LINE_FLAG_COMMENT_SEMICOLON;
-          // TODO: Install '%' feature
-          // } else if (c == '%') {
-            // Program start-end percent sign NOT SUPPORTED.
-            // NOTE: This maybe installed to tell Grbl when a program is running vs manual input,
-            // where, during a program, the system auto-cycle start will continue to execute
-            // everything until the next '%' sign. This will help fix resuming issues with certain
-            // functions that empty the planner buffer to execute its task on-time.
           } else if (char_counter >= (LINE_BUFFER_SIZE-1)) {
             // Detect line buffer overflow and set flag.
             line_flags |= LINE_FLAG_OVERFLOW;
@@ -152,10 +172,21 @@ void protocol_main_loop()
       }
     }
 
+    // Queue any pending motions of a canned cycle, as the planner buffer frees up.
+    mc_generator_run();
+
     // If there are no more characters in the serial read buffer to be processed and executed,
     // this indicates that g-code streaming has either filled the planner buffer or has
     // completed. In either case, auto-cycle start, if enabled, any queued moves.
-    protocol_auto_cycle_start();
+    #ifdef ENABLE_AUTO_CYCLE_START_POLICY
+      protocol_auto_cycle_start_buffered();
+    #else
+      #ifdef ENABLE_PROGRAM_MODE
+        if (program_running) { protocol_auto_cycle_start_buffered(); }
+        else
+      #endif
+      protocol_auto_cycle_start();
+    #endif
 
     protocol_execute_realtime();  // Runtime command check point.
     if (sys.abort) { return; } // Bail to main() program loop to reset system.
@@ -174,6 +205,7 @@ void protocol_main_loop()
 // during a synchronize call, if it should happen. Also, waits for clean cycle end.
 void protocol_buffer_synchronize()
 {
+  mc_generator_finish(); // Queue any pending generator motions first.
   // If system is queued, ensure cycle resumes if the auto start flag is present.
   protocol_auto_cycle_start();
   do {
@@ -197,6 +229,39 @@ void protocol_auto_cycle_start()
 }
 
 
+#if defined(ENABLE_PROGRAM_MODE) || defined(ENABLE_AUTO_CYCLE_START_POLICY)
+  // Auto-cycle start used by the main loop while streaming, per the start policy in config.h. An
+  // empty serial read buffer only means the host is slower than Grbl for a moment, so starting right
+  // away would run a few short blocks and decelerate to a stop waiting on the next ones. Instead,
+  // wait until the buffered motions are long enough in distance or execution time to ride out the
+  // host latency, or until the motions have waited AUTO_CYCLE_START_TIMEOUT milliseconds.
+  // NOTE: A full planner buffer and buffer syncs still start the cycle immediately. The checks are
+  // ordered by cost, since the buffered distance and time each walk the planner buffer.
+  static void protocol_auto_cycle_start_buffered()
+  {
+    if ((sys.state != STATE_IDLE) || (plan_get_current_block() == NULL)) {
+      cycle_start_pending = false; // Cycle already running, or nothing to start.
+      return;
+    }
+    if (!cycle_start_pending) {
+      cycle_start_pending = true;
+      cycle_start_pending_ms = tick_get_ms();
+    }
+    if (plan_check_full_buffer() ||
+        ((uint16_t)(tick_get_ms()-cycle_start_pending_ms) >= AUTO_CYCLE_START_TIMEOUT)
+        #ifdef AUTO_CYCLE_START_DISTANCE
+          || (plan_get_buffered_millimeters() >= AUTO_CYCLE_START_DISTANCE)
+        #endif
+        #ifdef AUTO_CYCLE_START_TIME
+          || (plan_get_buffered_time() >= (AUTO_CYCLE_START_TIME/60000.0))
+        #endif
+       ) {
+      system_set_exec_state_flag(EXEC_CYCLE_START);
+    }
+  }
+#endif
+
+
 // This function is the general interface to Grbl's real-time command execution system. It is called
 // from various check points in the main program, primarily where there may be a while loop waiting
 // for a buffer to clear space or any point where the execution time from the last check point may
@@ -239,9 +304,15 @@ void protocol_exec_rt_system()
         // incoming stream. The same could be said about soft limits. While the position is not
         // lost, continued streaming could cause a serious crash if by chance it gets executed.
         if (sys_rt_exec_state & EXEC_STATUS_REPORT) {
-          report_realtime_status();
           system_clear_exec_state_flag(EXEC_STATUS_REPORT);
+          report_realtime_status();
         }
+        #ifdef ENABLE_AUTO_REPORT
+          if (tick_auto_report_due) {
+            tick_auto_report_due = false;
+            report_auto_status();
+          }
+        #endif
       } while (bit_isfalse(sys_rt_exec_state,EXEC_RESET));
     }
     system_clear_exec_alarm(); // Clear alarm
@@ -258,8 +329,8 @@ void protocol_exec_rt_system()
 
     // Execute and serial print status
     if (rt_exec & EXEC_STATUS_REPORT) {
+      system_clear_exec_state_flag(EXEC_STATUS_REPORT); // Before, so a deferred report is raised again.
       report_realtime_status();
-      system_clear_exec_state_flag(EXEC_STATUS_REPORT);
     }
 
     // NOTE: Once hold is initiated, the system immediately enters a suspend state to block all
@@ -491,6 +562,14 @@ void protocol_exec_rt_system()
     }
   }
 
+  // Execute and serial print push status report, when the auto report interval has elapsed.
+  #ifdef ENABLE_AUTO_REPORT
+    if (tick_auto_report_due) {
+      tick_auto_report_due = false;
+      report_auto_status();
+    }
+  #endif
+
   // Reload step segment buffer
   if (sys.state & (STATE_CYCLE | STATE_HOLD | STATE_SAFETY_DOOR | STATE_HOMING | STATE_SLEEP| STATE_JOG)) {
     st_prep_buffer();
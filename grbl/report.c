@@ -249,7 +249,13 @@ void report_init_message()
 
 // Grbl help message
 void report_grbl_help() {
-  printPgmString(PSTR("[HLP:$$ $# $D $G $I $N $x=val $Nx=line $J=line $SLP $C $X $H ~ ! ? ctrl-x]\r\n"));
+  #if defined(ENABLE_HEIGHT_MAP)
+    printPgmString(PSTR("[HLP:$$ $# $D $G $I $N $P $PC $M $MP $MC $x=val $Nx=line $J=line $SLP $C $X $H ~ ! ? ctrl-x]\r\n"));
+  #elif defined(ENABLE_PROBE_RESULT_BUFFER)
+    printPgmString(PSTR("[HLP:$$ $# $D $G $I $N $P $PC $x=val $Nx=line $J=line $SLP $C $X $H ~ ! ? ctrl-x]\r\n"));
+  #else
+    printPgmString(PSTR("[HLP:$$ $# $D $G $I $N $x=val $Nx=line $J=line $SLP $C $X $H ~ ! ? ctrl-x]\r\n"));
+  #endif
 }
 
 
@@ -318,7 +324,7 @@ void report_probe_parameters()
   // Report in terms of machine position.
   printPgmString(PSTR("[PRB:"));
   float print_position[N_AXIS];
-  system_convert_array_steps_to_mpos(print_position,sys_probe_position);
+  probe_get_position(print_position);
   report_util_axis_values(print_position);
   serial_write(':');
   print_uint8_base10(sys.probe_succeeded);
@@ -326,6 +332,58 @@ void report_probe_parameters()
 }
 
 
+#ifdef ENABLE_PROBE_RESULT_BUFFER
+  // Prints the stored probe results, oldest first, as [PRBn:positions:success:line number].
+  void report_probe_results()
+  {
+    probe_result_t result;
+    uint8_t index = 0;
+    while (probe_read_result(index, &result)) {
+      printPgmString(PSTR("[PRB"));
+      print_uint8_base10(index++);
+      serial_write(':');
+      report_util_axis_values(result.position);
+      serial_write(':');
+      print_uint8_base10(result.succeeded);
+      serial_write(':');
+      printInteger(result.line_number);
+      report_util_feedback_line_feed();
+    }
+  }
+#endif
+
+
+#ifdef ENABLE_HEIGHT_MAP
+  // Prints the height map as [HMAP:origin x,y:spacing x,y:enabled], then each row of Z offsets along X
+  // as [HMAPn:offsets].
+  void report_height_map()
+  {
+    uint8_t row, col;
+    printPgmString(PSTR("[HMAP:"));
+    printFloat_CoordValue(height_map.origin[0]);
+    serial_write(',');
+    printFloat_CoordValue(height_map.origin[1]);
+    serial_write(':');
+    printFloat_CoordValue(height_map.spacing[0]);
+    serial_write(',');
+    printFloat_CoordValue(height_map.spacing[1]);
+    serial_write(':');
+    print_uint8_base10(height_map.enabled);
+    report_util_feedback_line_feed();
+    for (row=0; row<HEIGHT_MAP_ROWS; row++) {
+      printPgmString(PSTR("[HMAP"));
+      print_uint8_base10(row);
+      serial_write(':');
+      for (col=0; col<HEIGHT_MAP_COLUMNS; col++) {
+        if (col) { serial_write(','); }
+        printFloat_CoordValue(height_map.offset[row][col]);
+      }
+      report_util_feedback_line_feed();
+    }
+  }
+#endif
+
+
 // Prints Grbl NGC parameters (coordinate offsets, probing)
 void report_ngc_parameters()
 {
@@ -346,12 +404,39 @@ void report_ngc_parameters()
     report_util_axis_values(coord_data);
     report_util_feedback_line_feed();
   }
+  #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+    if (gc_state.modal.coord_select >= SETTING_INDEX_EXTENDED) { // Print the active G54.1 system only
+      printPgmString(PSTR("[G54.1 P"));
+      print_uint8_base10(gc_state.modal.coord_select-(SETTING_INDEX_EXTENDED-1));
+      serial_write(':');
+      report_util_axis_values(gc_state.coord_system);
+      report_util_feedback_line_feed();
+    }
+  #endif
   printPgmString(PSTR("[G92:")); // Print G92,G92.1 which are not persistent in memory
   report_util_axis_values(gc_state.coord_offset);
   report_util_feedback_line_feed();
   printPgmString(PSTR("[TLO:")); // Print tool length offset value
   printFloat_CoordValue(gc_state.tool_length_offset);
   report_util_feedback_line_feed();
+  #ifdef ENABLE_COORD_TRANSFORM
+    // Print the G68 transform as [G68:center x,y:rotation:scale x,y:skew]
+    float transform_data[N_TRANSFORM_DATA];
+    transform_get(transform_data);
+    printPgmString(PSTR("[G68:"));
+    printFloat_CoordValue(transform_data[TRANSFORM_CENTER_X]);
+    serial_write(',');
+    printFloat_CoordValue(transform_data[TRANSFORM_CENTER_Y]);
+    serial_write(':');
+    printFloat(transform_data[TRANSFORM_ROTATION], N_DECIMAL_SETTINGVALUE);
+    serial_write(':');
+    printFloat(transform_data[TRANSFORM_SCALE_X], N_DECIMAL_SETTINGVALUE+2);
+    serial_write(',');
+    printFloat(transform_data[TRANSFORM_SCALE_Y], N_DECIMAL_SETTINGVALUE+2);
+    serial_write(':');
+    printFloat(transform_data[TRANSFORM_SKEW], N_DECIMAL_SETTINGVALUE);
+    report_util_feedback_line_feed();
+  #endif
   report_probe_parameters(); // Print probe parameters. Not persistent in memory.
 }
 
@@ -368,6 +453,12 @@ void report_gcode_modes()
   }
 
   report_util_gcode_modes_G();
+  #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+    if (gc_state.modal.coord_select >= SETTING_INDEX_EXTENDED) {
+      printPgmString(PSTR("54.1 P"));
+      print_uint8_base10(gc_state.modal.coord_select-(SETTING_INDEX_EXTENDED-1));
+    } else
+  #endif
   print_uint8_base10(gc_state.modal.coord_select+54);
 
   report_util_gcode_modes_G();
@@ -612,7 +703,8 @@ void report_echo_line_received(char *line)
  // specific needs, but the desired real-time data report must be as short as possible. This is
  // requires as it minimizes the computational overhead and allows grbl to keep running smoothly,
  // especially during g-code programs with fast, short line segments and high frequency reports (5-20Hz).
-void report_realtime_status()
+ // NOTE: Push reports with reduced fields leave out the buffer state and pin state fields.
+static void report_util_realtime_status(uint8_t reduced)
 {
   uint8_t idx;
   int32_t current_position[N_AXIS]; // Copy current state of the system position variable
@@ -678,7 +770,7 @@ void report_realtime_status()
 
   // Returns planner and serial read buffer states.
   #ifdef REPORT_FIELD_BUFFER_STATE
-    if (bit_istrue(settings.status_report_mask,BITFLAG_RT_STATUS_BUFFER_STATE)) {
+    if (!reduced && bit_istrue(settings.status_report_mask,BITFLAG_RT_STATUS_BUFFER_STATE)) {
       printPgmString(PSTR("|Bf:"));
       print_uint8_base10(plan_get_block_buffer_available());
       serial_write(',');
@@ -707,9 +799,18 @@ void report_realtime_status()
   #endif
 
   #ifdef REPORT_FIELD_PIN_STATE
-    uint8_t lim_pin_state = limits_get_state();
-    uint8_t ctrl_pin_state = system_control_get_state();
-    uint8_t prb_pin_state = probe_get_state();
+    uint8_t lim_pin_state = 0;
+    uint8_t ctrl_pin_state = 0;
+    uint8_t prb_pin_state = 0;
+    if (!reduced) {
+      #ifdef INPUT_FILTERED_LIMITS
+        lim_pin_state = input_filter_limits;
+      #else
+        lim_pin_state = limits_get_state();
+      #endif
+      ctrl_pin_state = system_control_get_state();
+      prb_pin_state = probe_get_state();
+    }
     if (lim_pin_state | ctrl_pin_state | prb_pin_state) {
       printPgmString(PSTR("|Pn:"));
       if (prb_pin_state) { serial_write('P'); }
@@ -816,6 +917,131 @@ void report_realtime_status()
 }
 
 
+#ifdef ENABLE_BINARY_STATUS_REPORT
+  static uint16_t report_binary_crc;
+
+  static void report_util_binary_bytes(void *data, uint8_t n)
+  {
+    uint8_t *ptr = (uint8_t*)data;
+    while (n--) {
+      report_binary_crc = _crc_xmodem_update(report_binary_crc, *ptr);
+      serial_write(*ptr++);
+    }
+  }
+
+
+  // Prints the real-time status as a fixed length binary frame. Costs a fraction of the text report
+  // in both CPU time and link bandwidth, since nothing is converted to decimal. All multi-byte
+  // values are little-endian. Frame layout:
+  //   start byte BINARY_STATUS_FRAME_START, payload length,
+  //   payload: state, suspend, machine position in steps (int32 per axis), planner blocks available,
+  //            serial RX bytes available, realtime feed rate in mm/min (float32), line number (int32),
+  //   CRC-16/XMODEM of the payload length and payload.
+  // NOTE: The frame has no line feed. It is only sent through the priority TX buffer between lines, so
+  // a host can tell it apart from text output by its start byte, which is never sent in a text line.
+  static void report_binary_status()
+  {
+    int32_t current_position[N_AXIS]; // Copy current state of the system position variable
+    memcpy(current_position,sys_position,sizeof(sys_position));
+    float feed_rate = st_get_realtime_rate();
+    int32_t line_number = 0;
+    plan_block_t * cur_block = plan_get_current_block();
+    if (cur_block != NULL) { line_number = cur_block->line_number; }
+    uint8_t data[4];
+
+    serial_write(BINARY_STATUS_FRAME_START);
+    report_binary_crc = 0;
+    data[0] = BINARY_STATUS_PAYLOAD_SIZE;
+    data[1] = sys.state;
+    data[2] = sys.suspend;
+    report_util_binary_bytes(data, 3);
+    report_util_binary_bytes(current_position, sizeof(current_position));
+    data[0] = plan_get_block_buffer_available();
+    data[1] = serial_get_rx_buffer_available();
+    report_util_binary_bytes(data, 2);
+    report_util_binary_bytes(&feed_rate, sizeof(float));
+    report_util_binary_bytes(&line_number, sizeof(int32_t));
+    serial_write(report_binary_crc & 0xff);
+    serial_write(report_binary_crc >> 8);
+  }
+#endif
+
+
+// Prints the status report in the format selected by the '$10' status report mask, ahead of any bulk
+// output waiting in the serial TX buffer. Returns false, without printing, while a text line is
+// partially written, so the report can't land in the middle of it. The caller retries later.
+static uint8_t report_util_status(uint8_t reduced)
+{
+  if (!serial_priority_begin()) { return(false); }
+  #ifdef ENABLE_BINARY_STATUS_REPORT
+    if (bit_istrue(settings.status_report_mask,BITFLAG_RT_STATUS_BINARY)) { report_binary_status(); }
+    else
+  #endif
+  report_util_realtime_status(reduced);
+  serial_priority_end();
+  return(true);
+}
+
+
+// Prints the real-time status report requested by the '?' realtime command. If deferred, the request
+// is raised again for the next realtime check point.
+void report_realtime_status()
+{
+  if (!report_util_status(false)) { system_set_exec_state_flag(EXEC_STATUS_REPORT); }
+}
+
+
+#ifdef ENABLE_AUTO_REPORT
+  // Prints a push status report when the auto report interval elapses. With changes-only enabled,
+  // the report is skipped while the machine state, position and line number are unchanged, except
+  // for a periodic keep-alive report.
+  void report_auto_status()
+  {
+    #ifdef AUTO_REPORT_CHANGES_ONLY
+      static int32_t last_position[N_AXIS];
+      static uint8_t last_state = 0xff;
+      static uint8_t last_suspend;
+      static int32_t last_line_number;
+      static uint16_t last_report_ms;
+
+      int32_t line_number = 0;
+      plan_block_t *cur_block = plan_get_current_block();
+      if (cur_block != NULL) { line_number = cur_block->line_number; }
+
+      int32_t position[N_AXIS];
+      uint8_t sreg = SREG;
+      cli(); // Position is updated by the stepper interrupt. Compare against a consistent copy.
+      memcpy(position, sys_position, sizeof(sys_position));
+      SREG = sreg;
+      uint8_t changed = memcmp(last_position, position, sizeof(position));
+      if ((sys.state != last_state) || (sys.suspend != last_suspend) || (line_number != last_line_number)) { changed = true; }
+      if (!changed && ((uint16_t)(tick_get_ms()-last_report_ms) < AUTO_REPORT_KEEPALIVE)) { return; }
+    #endif
+    #ifdef AUTO_REPORT_REDUCED_FIELDS
+      if (!report_util_status(true)) { tick_auto_report_due = true; return; } // Deferred. Retry next check point.
+    #else
+      if (!report_util_status(false)) { tick_auto_report_due = true; return; } // Deferred. Retry next check point.
+    #endif
+    #ifdef AUTO_REPORT_CHANGES_ONLY
+      memcpy(last_position, position, sizeof(position));
+      last_state = sys.state;
+      last_suspend = sys.suspend;
+      last_line_number = line_number;
+      last_report_ms = tick_get_ms();
+    #endif
+  }
+
+
+  // Prints the automatic status report interval.
+  void report_auto_report_interval()
+  {
+    printPgmString(PSTR("[RI:"));
+    print_uint16_base10(tick_get_auto_report_interval());
+    report_util_feedback_line_feed();
+  }
+#endif
+
+
 // Print digital input / output status
 void report_digital_status(uint8_t dg_state)
 {
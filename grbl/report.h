@@ -60,6 +60,12 @@
 #define STATUS_GCODE_UNUSED_WORDS 36
 #define STATUS_GCODE_G43_DYNAMIC_AXIS_ERROR 37
 #define STATUS_GCODE_MAX_VALUE_EXCEEDED 38
+#define STATUS_OWORD_INVALID_COMMAND 39
+#define STATUS_OWORD_UNDEFINED_SUB 40
+#define STATUS_OWORD_STORAGE_FULL 41
+#define STATUS_OWORD_CALL_DEPTH_EXCEEDED 42
+#define STATUS_OWORD_INVALID_PARAMETER 43
+#define STATUS_HEIGHT_MAP_INVALID 44
 
 // Define Grbl alarm codes. Valid values (1-255). 0 is reserved.
 #define ALARM_HARD_LIMIT_ERROR      EXEC_ALARM_HARD_LIMIT
@@ -85,6 +91,10 @@
 #define MESSAGE_SPINDLE_RESTORE 10
 #define MESSAGE_SLEEP_MODE 11
 
+// Define binary status report frame. See report.c for the frame layout.
+#define BINARY_STATUS_FRAME_START 0xA5 // Never sent in text output, which is 7-bit ASCII.
+#define BINARY_STATUS_PAYLOAD_SIZE (12+4*N_AXIS) // State through line number, in bytes.
+
 // Prints system status messages.
 void report_status_message(uint8_t status_code);
 
@@ -110,9 +120,23 @@ void report_echo_line_received(char *line);
 // Prints realtime status report
 void report_realtime_status();
 
+// Prints push status report and its interval, if auto reporting is enabled.
+void report_auto_status();
+void report_auto_report_interval();
+
 // Prints recorded probe position
 void report_probe_parameters();
 
+#ifdef ENABLE_PROBE_RESULT_BUFFER
+  // Prints the probe result buffer
+  void report_probe_results();
+#endif
+
+#ifdef ENABLE_HEIGHT_MAP
+  // Prints the height map grid and offsets
+  void report_height_map();
+#endif
+
 // Prints Grbl NGC parameters (coordinate offsets, probe)
 void report_ngc_parameters();
 
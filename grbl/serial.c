@@ -33,6 +33,26 @@ uint8_t serial_tx_buffer[TX_RING_BUFFER];
 uint8_t serial_tx_buffer_head = 0;
 volatile uint8_t serial_tx_buffer_tail = 0;
 
+#ifdef ENABLE_TX_PRIORITY_BUFFER
+  #define TX_PRIORITY_RING_BUFFER (TX_PRIORITY_BUFFER_SIZE+1)
+
+  // Define which stream owns the line currently being sent by the TX interrupt. Output is never
+  // interleaved, so the priority stream only cuts in at line boundaries of the normal stream. The
+  // priority stream keeps the line until its writer is done and its buffer is sent, so it may also
+  // carry binary data.
+  #define TX_LINE_OWNER_NONE      0
+  #define TX_LINE_OWNER_NORMAL    1
+  #define TX_LINE_OWNER_PRIORITY  2
+
+  uint8_t serial_tx_priority_buffer[TX_PRIORITY_RING_BUFFER];
+  uint8_t serial_tx_priority_head = 0;
+  volatile uint8_t serial_tx_priority_tail = 0;
+  volatile uint8_t serial_tx_line_owner = TX_LINE_OWNER_NONE;
+
+  volatile uint8_t serial_tx_priority_selected = false; // Main program writes to the priority buffer when true.
+  static uint8_t serial_tx_normal_mid_line = false; // Last byte written to the normal buffer was not a line feed.
+#endif
+
 
 // Returns the number of bytes available in the RX serial buffer.
 uint8_t serial_get_rx_buffer_available()
@@ -83,44 +103,151 @@ void serial_init()
 }
 
 
+// Called while waiting for room in a full TX buffer. Keeps the step segment buffer fed, so long
+// reports like '$$' or '$#' can't starve the stepper during a cycle. Status report requests are
+// also serviced here through the priority buffer, if the normal stream is at a line boundary.
+// NOTE: Only the segment generator and status reports are run. The rest of the realtime system is
+// not re-entrant and is left to protocol_execute_realtime() once the report completes.
+static void serial_tx_wait()
+{
+  if (sys.state & (STATE_CYCLE | STATE_HOLD | STATE_SAFETY_DOOR | STATE_HOMING | STATE_SLEEP | STATE_JOG)) {
+    st_prep_buffer();
+  }
+  #ifdef ENABLE_TX_PRIORITY_BUFFER
+    if (!serial_tx_priority_selected && !serial_tx_normal_mid_line) {
+      if (sys_rt_exec_state & EXEC_STATUS_REPORT) {
+        system_clear_exec_state_flag(EXEC_STATUS_REPORT); // Before, so a deferred report is raised again.
+        report_realtime_status();
+      }
+      #ifdef ENABLE_AUTO_REPORT
+        if (tick_auto_report_due) {
+          tick_auto_report_due = false;
+          report_auto_status();
+        }
+      #endif
+    }
+  #endif
+}
+
+
 // Writes one byte to the TX serial buffer. Called by main program.
 void serial_write(uint8_t data) {
+  #ifdef ENABLE_TX_PRIORITY_BUFFER
+    if (serial_tx_priority_selected) {
+      uint8_t next_head = serial_tx_priority_head + 1;
+      if (next_head == TX_PRIORITY_RING_BUFFER) { next_head = 0; }
+      while (next_head == serial_tx_priority_tail) {
+        if (sys_rt_exec_state & EXEC_RESET) { return; } // Only check for abort to avoid an endless loop.
+        serial_tx_wait();
+      }
+      serial_tx_priority_buffer[serial_tx_priority_head] = data;
+      serial_tx_priority_head = next_head;
+      UCSR0B |=  (1 << UDRIE0);
+      return;
+    }
+  #endif
+
   // Calculate next head
   uint8_t next_head = serial_tx_buffer_head + 1;
   if (next_head == TX_RING_BUFFER) { next_head = 0; }
 
   // Wait until there is space in the buffer
   while (next_head == serial_tx_buffer_tail) {
-    // TODO: Restructure st_prep_buffer() calls to be executed here during a long print.
     if (sys_rt_exec_state & EXEC_RESET) { return; } // Only check for abort to avoid an endless loop.
+    serial_tx_wait();
   }
 
   // Store data and advance head
   serial_tx_buffer[serial_tx_buffer_head] = data;
   serial_tx_buffer_head = next_head;
+  #ifdef ENABLE_TX_PRIORITY_BUFFER
+    serial_tx_normal_mid_line = (data != '\n');
+  #endif
 
   // Enable Data Register Empty Interrupt to make sure tx-streaming is running
   UCSR0B |=  (1 << UDRIE0);
 }
 
 
-// Data Register Empty Interrupt handler
-ISR(SERIAL_UDRE)
+// Directs following writes to the priority TX buffer, which is sent ahead of any bulk output at the
+// next line boundary. Used by realtime status reports. Priority output only begins when the normal
+// stream holds complete lines, otherwise the report would wait on a line that can't be finished.
+// Without the priority buffer, writes always go to the normal TX buffer.
+uint8_t serial_priority_begin()
 {
-  uint8_t tail = serial_tx_buffer_tail; // Temporary serial_tx_buffer_tail (to optimize for volatile)
+  #ifdef ENABLE_TX_PRIORITY_BUFFER
+    if (serial_tx_normal_mid_line) { return(false); }
+    serial_tx_priority_selected = true;
+  #endif
+  return(true);
+}
 
-  // Send a byte from the buffer
-  UDR0 = serial_tx_buffer[tail];
 
-  // Update tail position
-  tail++;
-  if (tail == TX_RING_BUFFER) { tail = 0; }
+// Restores writes to the normal TX buffer.
+void serial_priority_end()
+{
+  #ifdef ENABLE_TX_PRIORITY_BUFFER
+    serial_tx_priority_selected = false;
+    UCSR0B |=  (1 << UDRIE0); // Let the TX interrupt hand the line back to the normal stream.
+  #endif
+}
 
-  serial_tx_buffer_tail = tail;
 
-  // Turn off Data Register Empty Interrupt to stop tx-streaming if this concludes the transfer
-  if (tail == serial_tx_buffer_head) { UCSR0B &= ~(1 << UDRIE0); }
-}
+// Data Register Empty Interrupt handler
+#ifdef ENABLE_TX_PRIORITY_BUFFER
+  ISR(SERIAL_UDRE)
+  {
+    uint8_t tail = serial_tx_buffer_tail; // Temporary serial_tx_buffer_tail (to optimize for volatile)
+    uint8_t priority_tail = serial_tx_priority_tail;
+    uint8_t owner = serial_tx_line_owner;
+    uint8_t data;
+
+    // Release the line once the priority writer is done and all of its output is sent.
+    if ((owner == TX_LINE_OWNER_PRIORITY) && !serial_tx_priority_selected &&
+        (priority_tail == serial_tx_priority_head)) { owner = TX_LINE_OWNER_NONE; }
+
+    // Send a byte from the priority buffer, unless a normal line is in progress.
+    if ((owner != TX_LINE_OWNER_NORMAL) && (priority_tail != serial_tx_priority_head)) {
+      UDR0 = serial_tx_priority_buffer[priority_tail];
+      priority_tail++;
+      if (priority_tail == TX_PRIORITY_RING_BUFFER) { priority_tail = 0; }
+      serial_tx_priority_tail = priority_tail;
+      owner = TX_LINE_OWNER_PRIORITY;
+      if (!serial_tx_priority_selected && (priority_tail == serial_tx_priority_head)) { owner = TX_LINE_OWNER_NONE; }
+    } else if ((owner != TX_LINE_OWNER_PRIORITY) && (tail != serial_tx_buffer_head)) {
+      data = serial_tx_buffer[tail];
+      UDR0 = data;
+      tail++;
+      if (tail == TX_RING_BUFFER) { tail = 0; }
+      serial_tx_buffer_tail = tail;
+      if (data == '\n') { owner = TX_LINE_OWNER_NONE; } else { owner = TX_LINE_OWNER_NORMAL; }
+    }
+    serial_tx_line_owner = owner;
+
+    // Turn off Data Register Empty Interrupt when nothing more can be sent. The main program
+    // re-enables it upon writing the remainder of a partially written line.
+    uint8_t priority_pending = (owner != TX_LINE_OWNER_NORMAL) && (priority_tail != serial_tx_priority_head);
+    uint8_t normal_pending = (owner != TX_LINE_OWNER_PRIORITY) && (tail != serial_tx_buffer_head);
+    if (!(priority_pending || normal_pending)) { UCSR0B &= ~(1 << UDRIE0); }
+  }
+#else
+  ISR(SERIAL_UDRE)
+  {
+    uint8_t tail = serial_tx_buffer_tail; // Temporary serial_tx_buffer_tail (to optimize for volatile)
+
+    // Send a byte from the buffer
+    UDR0 = serial_tx_buffer[tail];
+
+    // Update tail position
+    tail++;
+    if (tail == TX_RING_BUFFER) { tail = 0; }
+
+    serial_tx_buffer_tail = tail;
+
+    // Turn off Data Register Empty Interrupt to stop tx-streaming if this concludes the transfer
+    if (tail == serial_tx_buffer_head) { UCSR0B &= ~(1 << UDRIE0); }
+  }
+#endif
 
 
 // Fetches the first byte in the serial read buffer. Called by main program.
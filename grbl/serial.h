@@ -31,6 +31,10 @@
   #define TX_BUFFER_SIZE 255
 #endif
 
+#ifndef TX_PRIORITY_BUFFER_SIZE
+  #define TX_PRIORITY_BUFFER_SIZE 127
+#endif
+
 #define SERIAL_NO_DATA 0xff
 
 
@@ -39,6 +43,12 @@ void serial_init();
 // Writes one byte to the TX serial buffer. Called by main program.
 void serial_write(uint8_t data);
 
+// Directs following writes to the priority TX buffer, sent ahead of bulk output at the next
+// line boundary. Used by realtime status reports. Returns false, with writes left to the normal TX
+// buffer, while a normal line is partially written.
+uint8_t serial_priority_begin();
+void serial_priority_end();
+
 // Write à string to the TX serial buffer. (for debugging)
 void serial_putstring(char* StringPtr);
 
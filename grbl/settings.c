@@ -87,6 +87,22 @@ const __flash settings_t defaults = {
 #endif
 };
 
+// Work coordinate systems and G28/G30 positions, cached from EEPROM upon startup. Coordinate system
+// changes, go-home moves and parameter reports read the cache only. Writes update both.
+static float coord_data_cache[SETTING_INDEX_NCOORD+1][N_AXIS];
+static uint8_t coord_data_read_fail; // Flags the sets whose EEPROM checksum failed upon startup.
+
+#ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+  // The G54.1 extended coordinate systems are too many to cache all. The most recently used ones are
+  // kept instead, replaced in round-robin order.
+  typedef struct {
+    uint8_t coord_select; // Zero, if the entry is unused.
+    float coord_data[N_AXIS];
+  } extended_coord_cache_t;
+  static extended_coord_cache_t extended_coord_cache[EXTENDED_COORD_CACHE_SIZE];
+  static uint8_t extended_coord_cache_next;
+#endif
+
 // Method to store startup lines into EEPROM
 void settings_store_startup_line(uint8_t n, char *line)
 {
@@ -107,17 +123,127 @@ void settings_store_build_info(char *line)
 }
 
 
-// Method to store coord data parameters into EEPROM
+#ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+  // Returns the RAM cache entry of an extended coordinate system. Claims the next entry, if not cached.
+  static extended_coord_cache_t *settings_cache_extended_coord(uint8_t coord_select)
+  {
+    uint8_t idx;
+    for (idx=0; idx<EXTENDED_COORD_CACHE_SIZE; idx++) {
+      if (extended_coord_cache[idx].coord_select == coord_select) { return(&extended_coord_cache[idx]); }
+    }
+    extended_coord_cache_t *entry = &extended_coord_cache[extended_coord_cache_next];
+    if (++extended_coord_cache_next == EXTENDED_COORD_CACHE_SIZE) { extended_coord_cache_next = 0; }
+    entry->coord_select = coord_select;
+    return(entry);
+  }
+
+
+  // Unpacks the 24-bit micron offsets of an extended coordinate system, as stored in EEPROM.
+  static void settings_unpack_extended_coord(uint8_t *packed, float *coord_data)
+  {
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      int32_t offset = (int8_t)packed[2]; // Sign extends the most significant byte.
+      offset = (offset << 8) | packed[1];
+      offset = (offset << 8) | packed[0];
+      coord_data[idx] = offset*0.001;
+      packed += 3;
+    }
+  }
+
+
+  // Stores an extended coordinate system into EEPROM and the RAM cache. The cache keeps the values
+  // rounded to the micron, as read back from EEPROM.
+  static void settings_write_extended_coord(uint8_t coord_select, float *coord_data)
+  {
+    uint8_t packed[EXTENDED_COORD_SIZE];
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      int32_t offset = lround(coord_data[idx]*1000.0);
+      packed[3*idx] = offset;
+      packed[3*idx+1] = offset >> 8;
+      packed[3*idx+2] = offset >> 16;
+    }
+    settings_unpack_extended_coord(packed, settings_cache_extended_coord(coord_select)->coord_data);
+    uint32_t addr = (coord_select-SETTING_INDEX_EXTENDED)*(EXTENDED_COORD_SIZE+1) + EEPROM_ADDR_EXTENDED_COORD;
+    memcpy_to_eeprom_with_checksum(addr,(char*)packed, EXTENDED_COORD_SIZE);
+  }
+
+
+  // Reads an extended coordinate system from the RAM cache, or from EEPROM if not cached. A system
+  // failing its checksum is reset with the default zero vector and returns false.
+  static uint8_t settings_read_extended_coord(uint8_t coord_select, float *coord_data)
+  {
+    uint8_t idx;
+    for (idx=0; idx<EXTENDED_COORD_CACHE_SIZE; idx++) {
+      if (extended_coord_cache[idx].coord_select == coord_select) {
+        memcpy(coord_data, extended_coord_cache[idx].coord_data, sizeof(float)*N_AXIS);
+        return(true);
+      }
+    }
+    uint8_t packed[EXTENDED_COORD_SIZE];
+    uint32_t addr = (coord_select-SETTING_INDEX_EXTENDED)*(EXTENDED_COORD_SIZE+1) + EEPROM_ADDR_EXTENDED_COORD;
+    if (!(memcpy_from_eeprom_with_checksum((char*)packed, addr, EXTENDED_COORD_SIZE))) {
+      clear_vector_float(coord_data);
+      settings_write_extended_coord(coord_select, coord_data);
+      return(false);
+    }
+    extended_coord_cache_t *entry = settings_cache_extended_coord(coord_select);
+    settings_unpack_extended_coord(packed, entry->coord_data);
+    memcpy(coord_data, entry->coord_data, sizeof(float)*N_AXIS);
+    return(true);
+  }
+#endif
+
+
+// Method to store coord data parameters into EEPROM and its RAM cache
 void settings_write_coord_data(uint8_t coord_select, float *coord_data)
 {
-  #ifdef FORCE_BUFFER_SYNC_DURING_EEPROM_WRITE
+  #if defined(FORCE_BUFFER_SYNC_DURING_EEPROM_WRITE) && !defined(ENABLE_EEPROM_WRITE_QUEUE)
     protocol_buffer_synchronize();
   #endif
+  #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+    if (coord_select >= SETTING_INDEX_EXTENDED) {
+      settings_write_extended_coord(coord_select, coord_data);
+      return;
+    }
+  #endif
+  memcpy(coord_data_cache[coord_select], coord_data, sizeof(float)*N_AXIS);
   uint32_t addr = coord_select*(sizeof(float)*N_AXIS+1) + EEPROM_ADDR_PARAMETERS;
   memcpy_to_eeprom_with_checksum(addr,(char*)coord_data, sizeof(float)*N_AXIS);
 }
 
 
+#ifdef ENABLE_COORD_TRANSFORM
+  void settings_write_transform(float *transform_data)
+  {
+    #if defined(FORCE_BUFFER_SYNC_DURING_EEPROM_WRITE) && !defined(ENABLE_EEPROM_WRITE_QUEUE)
+      protocol_buffer_synchronize();
+    #endif
+    memcpy_to_eeprom_with_checksum(EEPROM_ADDR_TRANSFORM, (char*)transform_data, sizeof(float)*N_TRANSFORM_DATA);
+  }
+
+
+  // Sets the transform data to the identity: no rotation or skew, and unit scales.
+  static void settings_clear_transform(float *transform_data)
+  {
+    memset(transform_data, 0, sizeof(float)*N_TRANSFORM_DATA);
+    transform_data[TRANSFORM_SCALE_X] = 1.0;
+    transform_data[TRANSFORM_SCALE_Y] = 1.0;
+  }
+
+
+  uint8_t settings_read_transform(float *transform_data)
+  {
+    if (!(memcpy_from_eeprom_with_checksum((char*)transform_data, EEPROM_ADDR_TRANSFORM, sizeof(float)*N_TRANSFORM_DATA))) {
+      settings_clear_transform(transform_data);
+      return(false);
+    }
+    return(true);
+  }
+#endif
+
+
 // Method to store Grbl global settings struct and version number into EEPROM
 // NOTE: This function can only be called in IDLE state.
 void write_global_settings()
@@ -139,6 +265,16 @@ void settings_restore(uint8_t restore_flag) {
     float coord_data[N_AXIS];
     memset(&coord_data, 0, sizeof(coord_data));
     for (idx=0; idx <= SETTING_INDEX_NCOORD; idx++) { settings_write_coord_data(idx, coord_data); }
+    #ifdef ENABLE_COORD_TRANSFORM
+      float transform_data[N_TRANSFORM_DATA];
+      settings_clear_transform(transform_data);
+      settings_write_transform(transform_data);
+    #endif
+    #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+      for (idx=SETTING_INDEX_EXTENDED; idx < SETTING_INDEX_EXTENDED+N_EXTENDED_COORDINATE_SYSTEM; idx++) {
+        settings_write_coord_data(idx, coord_data);
+      }
+    #endif
   }
 
   if (restore_flag & SETTINGS_RESTORE_STARTUP_LINES) {
@@ -156,6 +292,10 @@ void settings_restore(uint8_t restore_flag) {
     eeprom_put_char(EEPROM_ADDR_BUILD_INFO , 0);
     eeprom_put_char(EEPROM_ADDR_BUILD_INFO+1 , 0); // Checksum
   }
+
+  #ifdef ENABLE_O_WORD_SUBROUTINES
+    if (restore_flag & SETTINGS_RESTORE_SUBROUTINES) { oword_restore(); }
+  #endif
 }
 
 
@@ -186,20 +326,38 @@ uint8_t settings_read_build_info(char *line)
 }
 
 
-// Read selected coordinate data from EEPROM. Updates pointed coord_data value.
+// Read selected coordinate data from the RAM cache. Updates pointed coord_data value. Returns false
+// once for a set that failed its EEPROM checksum upon startup, which was reset to zero then.
 uint8_t settings_read_coord_data(uint8_t coord_select, float *coord_data)
 {
-  uint32_t addr = coord_select*(sizeof(float)*N_AXIS+1) + EEPROM_ADDR_PARAMETERS;
-  if (!(memcpy_from_eeprom_with_checksum((char*)coord_data, addr, sizeof(float)*N_AXIS))) {
-    // Reset with default zero vector
-    clear_vector_float(coord_data);
-    settings_write_coord_data(coord_select,coord_data);
+  #ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+    if (coord_select >= SETTING_INDEX_EXTENDED) { return(settings_read_extended_coord(coord_select, coord_data)); }
+  #endif
+  memcpy(coord_data, coord_data_cache[coord_select], sizeof(float)*N_AXIS);
+  if (bit_istrue(coord_data_read_fail,bit(coord_select))) {
+    bit_false(coord_data_read_fail,bit(coord_select));
     return(false);
   }
   return(true);
 }
 
 
+// Loads all coordinate data from EEPROM into the RAM cache. A set failing its checksum is reset with
+// the default zero vector.
+static void settings_load_coord_data()
+{
+  uint8_t idx;
+  for (idx=0; idx <= SETTING_INDEX_NCOORD; idx++) {
+    uint32_t addr = idx*(sizeof(float)*N_AXIS+1) + EEPROM_ADDR_PARAMETERS;
+    if (!(memcpy_from_eeprom_with_checksum((char*)coord_data_cache[idx], addr, sizeof(float)*N_AXIS))) {
+      clear_vector_float(coord_data_cache[idx]);
+      memcpy_to_eeprom_with_checksum(addr,(char*)coord_data_cache[idx], sizeof(float)*N_AXIS);
+      coord_data_read_fail |= bit(idx);
+    }
+  }
+}
+
+
 // Reads Grbl global settings struct from EEPROM.
 uint8_t read_global_settings() {
   // Check version-byte of eeprom
@@ -351,6 +509,7 @@ void settings_init() {
     report_debug_string("settings_init() Ok.");
   }
   #endif
+  settings_load_coord_data();
 }
 
 
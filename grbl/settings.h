@@ -31,7 +31,13 @@
 
 // Version of the EEPROM data. Will be used to migrate existing data from older versions of Grbl
 // when firmware is upgraded. Always stored in byte 0 of eeprom
-#define SETTINGS_VERSION 10  // NOTE: Check settings_reset() when moving to next version.
+// The extended coordinate systems move the o-word subroutines, so their layout has its own version.
+// Switching the option then restores all the EEPROM data, instead of reading one as the other.
+#ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+  #define SETTINGS_VERSION 11  // NOTE: Check settings_reset() when moving to next version.
+#else
+  #define SETTINGS_VERSION 10
+#endif
 
 // Define bit flag masks for the boolean settings in settings.flag.
 #define BIT_REPORT_INCHES      0
@@ -55,12 +61,14 @@
 // Define status reporting boolean enable bit flags in settings.status_report_mask
 #define BITFLAG_RT_STATUS_POSITION_TYPE     bit(0)
 #define BITFLAG_RT_STATUS_BUFFER_STATE      bit(1)
+#define BITFLAG_RT_STATUS_BINARY            bit(2) // Requires ENABLE_BINARY_STATUS_REPORT in config.h
 
 // Define settings restore bitflags.
 #define SETTINGS_RESTORE_DEFAULTS bit(0)
 #define SETTINGS_RESTORE_PARAMETERS bit(1)
 #define SETTINGS_RESTORE_STARTUP_LINES bit(2)
 #define SETTINGS_RESTORE_BUILD_INFO bit(3)
+#define SETTINGS_RESTORE_SUBROUTINES bit(4)
 #ifndef SETTINGS_RESTORE_ALL
   #define SETTINGS_RESTORE_ALL 0xFF // All bitflags
 #endif
@@ -70,6 +78,19 @@
 #define EEPROM_ADDR_PARAMETERS     512U
 #define EEPROM_ADDR_STARTUP_BLOCK  768U
 #define EEPROM_ADDR_BUILD_INFO     942U
+#define EEPROM_ADDR_TRANSFORM      736U // After the coordinate parameters of up to 6 axes.
+// NOTE: Startup lines and build info are stored LINE_BUFFER_SIZE long, so the extended coordinate
+// systems and subroutines start well clear of them. The remaining EEPROM is split into fixed size
+// subroutine slots.
+#ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+  #define EEPROM_ADDR_EXTENDED_COORD 1536U
+  #define EXTENDED_COORD_SIZE        (3*N_AXIS) // 24-bit offsets in microns. Each system adds a checksum byte.
+  #define EEPROM_ADDR_SUBROUTINES    (EEPROM_ADDR_EXTENDED_COORD+N_EXTENDED_COORDINATE_SYSTEM*(EXTENDED_COORD_SIZE+1))
+#else
+  #define EEPROM_ADDR_SUBROUTINES    1536U
+#endif
+#define OWORD_SUB_SIZE             512U // Slot size, including its 6 byte header.
+#define N_OWORD_SUB ((E2END+1-EEPROM_ADDR_SUBROUTINES)/OWORD_SUB_SIZE) // Number of stored subroutines
 
 // Define EEPROM address indexing for coordinate parameters
 #define N_COORDINATE_SYSTEM 6  // Number of supported work coordinate systems (from index 1)
@@ -78,6 +99,28 @@
 #define SETTING_INDEX_G28    N_COORDINATE_SYSTEM    // Home position 1
 #define SETTING_INDEX_G30    N_COORDINATE_SYSTEM+1  // Home position 2
 // #define SETTING_INDEX_G92    N_COORDINATE_SYSTEM+2  // Coordinate offset (G92.2,G92.3 not supported)
+#define SETTING_INDEX_EXTENDED (N_COORDINATE_SYSTEM+2) // G54.1 P1, followed by the other extended systems
+
+// Define the G68 coordinate transform data, stored at EEPROM_ADDR_TRANSFORM.
+#define TRANSFORM_CENTER_X 0 // Center of rotation, in machine coordinates
+#define TRANSFORM_CENTER_Y 1
+#define TRANSFORM_ROTATION 2 // Degrees, counterclockwise
+#define TRANSFORM_SCALE_X  3
+#define TRANSFORM_SCALE_Y  4
+#define TRANSFORM_SKEW     5 // Degrees of X skew along Y
+#define N_TRANSFORM_DATA   6
+#if (EEPROM_ADDR_PARAMETERS+(SETTING_INDEX_NCOORD+1)*(4*N_AXIS+1)) > EEPROM_ADDR_TRANSFORM
+  #error "The coordinate parameters overlap the coordinate transform in EEPROM."
+#endif
+
+#ifdef ENABLE_EXTENDED_COORDINATE_SYSTEMS
+  #if (N_EXTENDED_COORDINATE_SYSTEM < 1) || (N_EXTENDED_COORDINATE_SYSTEM > 99)
+    #error "N_EXTENDED_COORDINATE_SYSTEM must be from 1 to 99."
+  #endif
+  #if defined(ENABLE_O_WORD_SUBROUTINES) && (N_OWORD_SUB < 1)
+    #error "No EEPROM left for o-word subroutines. Reduce N_EXTENDED_COORDINATE_SYSTEM."
+  #endif
+#endif
 
 // Define Grbl axis settings numbering scheme. Starts at START_VAL, every INCREMENT, over N_SETTINGS.
 #define AXIS_N_SETTINGS          4
@@ -143,12 +186,22 @@ void settings_store_build_info(char *line);
 // Reads build info user-defined string
 uint8_t settings_read_build_info(char *line);
 
-// Writes selected coordinate data to EEPROM
+// Writes selected coordinate data to EEPROM and its RAM cache
 void settings_write_coord_data(uint8_t coord_select, float *coord_data);
 
-// Reads selected coordinate data from EEPROM
+// Reads selected coordinate data from its RAM cache, loaded from EEPROM upon startup. Extended
+// coordinate systems are read from EEPROM, unless recently used.
 uint8_t settings_read_coord_data(uint8_t coord_select, float *coord_data);
 
+#ifdef ENABLE_COORD_TRANSFORM
+  // Writes the G68 coordinate transform data to EEPROM
+  void settings_write_transform(float *transform_data);
+
+  // Reads the G68 coordinate transform data from EEPROM. Returns false and the identity transform
+  // upon a checksum failure.
+  uint8_t settings_read_transform(float *transform_data);
+#endif
+
 // Returns the step pin mask according to Grbl's internal axis numbering
 uint8_t get_step_pin_mask(uint8_t i);
 
@@ -371,14 +371,6 @@ ISR(TIMER1_COMPA_vect)
 
   if (busy) { return; } // The busy-flag is used to avoid reentering this interrupt
 
-  // Adding limit check status to implement hardware limits for RAMPS
-  // outside the changepin interrupt wich cannot be used
-  #ifdef ENABLE_RAMPS_HW_LIMITS
-    if (limits_get_state()) {
-      ramps_hard_limit();
-    }
-  #endif
-
   // Set the direction pins a couple of nanoseconds before we step the steppers
   DIRECTION_PORT(0) = (DIRECTION_PORT(0) & ~(1 << DIRECTION_BIT(0))) | st.dir_outbits[0];
   DIRECTION_PORT(1) = (DIRECTION_PORT(1) & ~(1 << DIRECTION_BIT(1))) | st.dir_outbits[1];
@@ -1255,3 +1247,25 @@ float st_get_realtime_rate()
   }
   return 0.0f;
 }
+
+
+#ifdef ENABLE_PROBE_CAPTURE
+  // Copies the Bresenham increments of each axis for the executing segment, signed by direction, and
+  // returns the step event count they are divided by, for a rate in steps per ISR tick. Used to
+  // interpolate a captured probe position. Called by the probe pin change interrupt, at the contact.
+  // Returns zero if no segment was executed since the last reset.
+  uint32_t st_get_tick_rate(int32_t *steps)
+  {
+    uint8_t idx;
+    if (st.exec_block == NULL) { return(0); }
+    for (idx=0; idx<N_AXIS; idx++) {
+      #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        steps[idx] = st.steps[idx];
+      #else
+        steps[idx] = st.exec_block->steps[idx];
+      #endif
+      if (st.exec_block->direction_bits[idx]) { steps[idx] = -steps[idx]; } // Direction pin set for negative motion
+    }
+    return(st.exec_block->step_event_count);
+  }
+#endif
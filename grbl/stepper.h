@@ -57,4 +57,9 @@ void st_update_plan_block_parameters();
 // Called by realtime status reporting if realtime rate reporting is enabled in config.h.
 float st_get_realtime_rate();
 
+#ifdef ENABLE_PROBE_CAPTURE
+  // Returns the step rates of the executing segment. Called by the probe pin change interrupt.
+  uint32_t st_get_tick_rate(int32_t *steps);
+#endif
+
 #endif
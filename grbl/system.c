@@ -30,15 +30,17 @@ void system_init()
   #else
     CONTROL_PORT |= CONTROL_MASK;   // Enable internal pull-up resistors. Normal high operation.
   #endif
-  CONTROL_PCMSK |= CONTROL_MASK;  // Enable specific pins of the Pin Change Interrupt
-  PCICR |= (1 << CONTROL_INT);   // Enable Pin Change Interrupt
+  #ifndef INPUT_FILTERED_CONTROL // Otherwise, the pins are sampled by the tick.
+    CONTROL_PCMSK |= CONTROL_MASK;  // Enable specific pins of the Pin Change Interrupt
+    PCICR |= (1 << CONTROL_INT);   // Enable Pin Change Interrupt
+  #endif
 }
 
 
 // Returns control pin state as a uint8 bitfield. Each bit indicates the input pin state, where
 // triggered is 1 and not triggered is 0. Invert mask is applied. Bitfield organization is
 // defined by the CONTROL_PIN_INDEX in the header file.
-uint8_t system_control_get_state()
+uint8_t system_control_get_pin_state()
 {
   uint8_t control_state = 0;
   uint8_t pin = (CONTROL_PIN & CONTROL_MASK);
@@ -55,13 +57,23 @@ uint8_t system_control_get_state()
 }
 
 
-// Pin change interrupt for pin-out commands, i.e. cycle start, feed hold, and reset. Sets
-// only the realtime command execute variable to have the main program execute these when
-// its ready. This works exactly like the character-based realtime commands when picked off
-// directly from the incoming serial data stream.
-ISR(CONTROL_INT_vect)
+// Returns the control pin state, filtered by the tick if enabled. Same bitfield as above.
+uint8_t system_control_get_state()
+{
+  #ifdef INPUT_FILTERED_CONTROL
+    return(input_filter_control);
+  #else
+    return(system_control_get_pin_state());
+  #endif
+}
+
+
+// Executes pin-out commands, i.e. cycle start, feed hold, and reset. Sets only the realtime
+// command execute variable to have the main program execute these when its ready. This works
+// exactly like the character-based realtime commands when picked off directly from the
+// incoming serial data stream. Called at an interrupt-level.
+void system_execute_control(uint8_t pin)
 {
-  uint8_t pin = system_control_get_state();
   if (pin) {
     if (bit_istrue(pin,CONTROL_PIN_INDEX_RESET)) {
       mc_reset();
@@ -76,6 +88,18 @@ ISR(CONTROL_INT_vect)
 }
 
 
+// Pin change interrupt for pin-out commands.
+#ifndef INPUT_FILTERED_CONTROL
+  ISR(CONTROL_INT_vect)
+  {
+    #if defined(ENABLE_PROBE_CAPTURE) && (PROBE_INT == CONTROL_INT)
+      probe_capture_edge(); // Probe pin on the same port
+    #endif
+    system_execute_control(system_control_get_pin_state());
+  }
+#endif
+
+
 // Returns if safety door is ajar(T) or closed(F), based on pin state.
 uint8_t system_check_safety_door_ajar()
 {
@@ -101,6 +125,28 @@ void system_execute_startup(char *line)
 }
 
 
+#ifdef ENABLE_AUTO_REPORT
+  // Prints or sets the push status report interval in milliseconds with '$RI' or '$RI=<ms>'.
+  // Allowed in any state, so a GUI may change the report rate during a job.
+  static uint8_t system_execute_auto_report(char *line)
+  {
+    if (line[3] == 0) {
+      report_auto_report_interval();
+      return(STATUS_OK);
+    }
+    if (line[3] != '=') { return(STATUS_INVALID_STATEMENT); }
+    uint8_t char_counter = 4;
+    float value;
+    if (!read_float(line, &char_counter, &value)) { return(STATUS_BAD_NUMBER_FORMAT); }
+    if (line[char_counter] != 0) { return(STATUS_INVALID_STATEMENT); }
+    if (value < 0.0) { return(STATUS_NEGATIVE_VALUE); }
+    if ((value > 65535.0) || ((value > 0.0) && (value < AUTO_REPORT_MIN_INTERVAL))) { return(STATUS_INVALID_STATEMENT); }
+    tick_set_auto_report_interval(trunc(value));
+    return(STATUS_OK);
+  }
+#endif
+
+
 // Directs and executes one line of formatted input from protocol_process. While mostly
 // incoming streaming g-code blocks, this also executes Grbl internal commands, such as
 // settings, initiating the homing cycle, and toggling switch states. This differs from
@@ -114,6 +160,9 @@ uint8_t system_execute_line(char *line)
   uint8_t char_counter = 1;
   uint8_t helper_var = 0; // Helper variable
   float parameter, value;
+  #ifdef ENABLE_AUTO_REPORT
+    if ((line[1] == 'R') && (line[2] == 'I')) { return(system_execute_auto_report(line)); }
+  #endif
   switch( line[char_counter] ) {
     case 0 : report_grbl_help(); break;
     case 'J' : // Jogging
@@ -174,6 +223,23 @@ uint8_t system_execute_line(char *line)
           if ( line[2] != 0 ) { return(STATUS_INVALID_STATEMENT); }
           else { report_ngc_parameters(); }
           break;
+        #ifdef ENABLE_PROBE_RESULT_BUFFER
+          case 'P' : // Print or clear the probe result buffer [IDLE/ALARM]
+            if ( line[2] == 0 ) { report_probe_results(); }
+            else if ((line[2] == 'C') && (line[3] == 0)) { probe_clear_results(); }
+            else { return(STATUS_INVALID_STATEMENT); }
+            break;
+        #endif
+        #ifdef ENABLE_HEIGHT_MAP
+          case 'M' : // Print, load from the probe results or clear the height map [IDLE/ALARM]
+            if ( line[2] == 0 ) { report_height_map(); break; }
+            mc_generator_finish(); // Pending motions are compensated with the map they were programmed on.
+            if ((line[2] == 'P') && (line[3] == 0)) { helper_var = height_map_load_probe_results(); }
+            else if ((line[2] == 'C') && (line[3] == 0)) { height_map_clear(); }
+            else { return(STATUS_INVALID_STATEMENT); }
+            gc_sync_position(); // The programmed position moves with the map offset.
+            return(helper_var);
+        #endif
         case 'H' : // Perform homing cycle [IDLE/ALARM]
           if (bit_isfalse(settings.flags,BITFLAG_HOMING_ENABLE)) {return(STATUS_SETTING_DISABLED); }
           if (system_check_safety_door_ajar()) { return(STATUS_CHECK_DOOR); } // Block if safety door is ajar.
@@ -182,75 +248,9 @@ uint8_t system_execute_line(char *line)
             mc_homing_cycle(HOMING_CYCLE_ALL);
           #ifdef HOMING_SINGLE_AXIS_COMMANDS
             } else if (line[3] == 0) {
-              switch (line[2]) {
-                case 'X': mc_homing_cycle(axis_X_mask); break;
-                case 'Y': mc_homing_cycle(axis_Y_mask); break;
-                case 'Z': mc_homing_cycle(axis_Z_mask); break;
-                case 'A':
-                  if (axis_A_mask != 0) {
-                    mc_homing_cycle(axis_A_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                case 'B':
-                  if (axis_B_mask != 0) {
-                    mc_homing_cycle(axis_B_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                case 'C':
-                  if (axis_C_mask != 0) {
-                    mc_homing_cycle(axis_C_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                case 'U':
-                  if (axis_U_mask != 0) {
-                    mc_homing_cycle(axis_U_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                case 'V':
-                  if (axis_V_mask != 0) {
-                    mc_homing_cycle(axis_V_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                case 'W':
-                  if (axis_W_mask != 0) {
-                    mc_homing_cycle(axis_W_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                case 'D':
-                  if (axis_D_mask != 0) {
-                    mc_homing_cycle(axis_D_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                case 'E':
-                  if (axis_E_mask != 0) {
-                    mc_homing_cycle(axis_E_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                case 'H':
-                  if (axis_H_mask != 0) {
-                    mc_homing_cycle(axis_H_mask);
-                  } else {
-                    return(STATUS_INVALID_STATEMENT);
-                  }
-                  break;
-                default: return(STATUS_INVALID_STATEMENT);
-              }
+              if ((line[2] < 'A') || (line[2] > 'Z')) { return(STATUS_INVALID_STATEMENT); }
+              if (get_axis_letter_mask(line[2]) == 0) { return(STATUS_INVALID_STATEMENT); } // No axis with this letter.
+              mc_homing_cycle(get_axis_letter_mask(line[2]));
           #endif // HOMING_SINGLE_AXIS_COMMANDS
           } else { return(STATUS_INVALID_STATEMENT); }
           if (!sys.abort) {  // Execute startup scripts after successful homing.
@@ -151,19 +151,6 @@ extern volatile uint8_t sys_rt_exec_state;   // Global realtime executor bitflag
 extern volatile uint8_t sys_rt_exec_alarm;   // Global realtime executor bitflag variable for setting various alarms.
 extern volatile uint8_t sys_rt_exec_motion_override; // Global realtime executor bitflag variable for motion-based overrides.
 extern volatile uint8_t sys_rt_exec_accessory_override; // Global realtime executor bitflag variable for spindle/coolant overrides.
-extern uint8_t axis_X_mask; // Global mask for axis X bits
-extern uint8_t axis_Y_mask; // Global mask for axis Y bits
-extern uint8_t axis_Z_mask; // Global mask for axis Z bits
-extern uint8_t axis_A_mask; // Global mask for axis A bits
-extern uint8_t axis_B_mask; // Global mask for axis B bits
-extern uint8_t axis_C_mask; // Global mask for axis C bits
-extern uint8_t axis_U_mask; // Global mask for axis A bits
-extern uint8_t axis_V_mask; // Global mask for axis B bits
-extern uint8_t axis_W_mask; // Global mask for axis C bits
-extern uint8_t axis_D_mask; // Global mask for axis A bits
-extern uint8_t axis_E_mask; // Global mask for axis B bits
-extern uint8_t axis_H_mask; // Global mask for axis C bits
-extern unsigned char axis_name[N_AXIS]; // Global table of axis names
 #ifdef DEBUG
   #define EXEC_DEBUG_REPORT  bit(0)
   extern volatile uint8_t sys_rt_exec_debug;
@@ -175,6 +162,12 @@ void system_init();
 // Returns bitfield of control pin states, organized by CONTROL_PIN_INDEX. (1=triggered, 0=not triggered).
 uint8_t system_control_get_state();
 
+// Same as above, but read directly from the pins, without input filtering.
+uint8_t system_control_get_pin_state();
+
+// Executes the commands of the triggered control pins, organized by CONTROL_PIN_INDEX.
+void system_execute_control(uint8_t pin);
+
 // Returns if safety door is open or closed, based on pin state.
 uint8_t system_check_safety_door_ajar();
 
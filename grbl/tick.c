@@ -0,0 +1,90 @@
+/*
+  tick.c - millisecond system tick for timed realtime events
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+
+// Timer5 in CTC mode with a 1/64 prescaler counts at 250kHz. 250 counts make one millisecond.
+#define TICK_TIMER_COMPARE ((F_CPU/64/1000)-1)
+
+volatile uint8_t tick_auto_report_due;
+
+static volatile uint16_t tick_ms;
+static volatile uint16_t auto_report_countdown;
+// NOTE: Kept through soft-resets, so a GUI only has to set the interval once per connection.
+static uint16_t auto_report_interval = AUTO_REPORT_INTERVAL;
+
+
+// Initialization routine for the tick timer. Called upon every reset.
+void tick_init()
+{
+  // Configure Timer 5: Millisecond tick compare match interrupt.
+  TIMSK5 &= ~(1<<OCIE5A); // Disable compare interrupt while configuring.
+  TCCR5A = 0;
+  TCCR5B = (1<<WGM52) | (1<<CS51) | (1<<CS50); // CTC mode on OCR5A. 1/64 prescaler.
+  OCR5A = TICK_TIMER_COMPARE;
+  TCNT5 = 0;
+  tick_auto_report_due = false;
+  auto_report_countdown = auto_report_interval;
+  TIMSK5 |= (1<<OCIE5A); // Enable timer5 compare interrupt
+}
+
+
+// Millisecond tick. Keep it short, since it runs alongside the stepper interrupts.
+ISR(TIMER5_COMPA_vect)
+{
+  tick_ms++;
+  #ifdef ENABLE_INPUT_FILTER
+    input_filter_update();
+  #endif
+  #if defined(ENABLE_RAMPS_HW_LIMITS) && !defined(INPUT_FILTERED_LIMITS)
+    ramps_hard_limit_poll(); // Hardware limits for RAMPS, where the pin change interrupt cannot be used.
+  #endif
+  if (auto_report_countdown) {
+    if (--auto_report_countdown == 0) {
+      auto_report_countdown = auto_report_interval;
+      tick_auto_report_due = true;
+    }
+  }
+}
+
+
+uint16_t tick_get_ms()
+{
+  uint8_t sreg = SREG;
+  cli();
+  uint16_t ms = tick_ms;
+  SREG = sreg;
+  return(ms);
+}
+
+
+void tick_set_auto_report_interval(uint16_t interval_ms)
+{
+  uint8_t sreg = SREG;
+  cli();
+  auto_report_interval = interval_ms;
+  auto_report_countdown = interval_ms;
+  tick_auto_report_due = false;
+  SREG = sreg;
+}
+
+
+uint16_t tick_get_auto_report_interval() { return(auto_report_interval); }
@@ -0,0 +1,43 @@
+/*
+  tick.h - millisecond system tick for timed realtime events
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef tick_h
+#define tick_h
+
+#ifndef AUTO_REPORT_INTERVAL
+  #define AUTO_REPORT_INTERVAL 0 // Push reports disabled at power-up.
+#endif
+
+// Set by the tick interrupt when an automatic status report is due. Cleared by main program.
+extern volatile uint8_t tick_auto_report_due;
+
+// Initialize and start the millisecond tick timer.
+void tick_init();
+
+// Returns the free running millisecond tick counter. Wraps around every ~65 seconds.
+uint16_t tick_get_ms();
+
+// Sets the automatic status report interval in milliseconds. Zero disables push reports.
+void tick_set_auto_report_interval(uint16_t interval_ms);
+
+// Returns the automatic status report interval in milliseconds.
+uint16_t tick_get_auto_report_interval();
+
+#endif
@@ -0,0 +1,103 @@
+/*
+  transform.c - G68 coordinate transform of the XY plane
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_COORD_TRANSFORM
+
+// Machine XY = center + matrix*(programmed XY - center). The matrix rotates the skewed and scaled
+// programmed plane: matrix = rotation*[1 tan(skew); 0 1]*[scale_x 0; 0 scale_y].
+typedef struct {
+  uint8_t enabled;   // False for the identity transform, which is skipped.
+  float data[N_TRANSFORM_DATA];
+  float matrix[4];   // Row major
+  float inverse[4];
+} transform_t;
+static transform_t transform;
+
+
+static void transform_compute()
+{
+  float *data = transform.data;
+  float cos_r = cos(data[TRANSFORM_ROTATION]*(M_PI/180.0));
+  float sin_r = sin(data[TRANSFORM_ROTATION]*(M_PI/180.0));
+  float skew = tan(data[TRANSFORM_SKEW]*(M_PI/180.0));
+  float scale_x = data[TRANSFORM_SCALE_X];
+  float scale_y = data[TRANSFORM_SCALE_Y];
+  transform.matrix[0] = cos_r*scale_x;
+  transform.matrix[1] = (cos_r*skew-sin_r)*scale_y;
+  transform.matrix[2] = sin_r*scale_x;
+  transform.matrix[3] = (sin_r*skew+cos_r)*scale_y;
+  // Rotation and skew keep areas, so the determinant is the product of the scales.
+  float det = scale_x*scale_y;
+  transform.inverse[0] = transform.matrix[3]/det;
+  transform.inverse[1] = -transform.matrix[1]/det;
+  transform.inverse[2] = -transform.matrix[2]/det;
+  transform.inverse[3] = transform.matrix[0]/det;
+  transform.enabled = (data[TRANSFORM_ROTATION] != 0.0) || (data[TRANSFORM_SKEW] != 0.0) ||
+                      (scale_x != 1.0) || (scale_y != 1.0);
+}
+
+
+void transform_init()
+{
+  settings_read_transform(transform.data); // Identity upon a checksum failure.
+  transform_compute();
+}
+
+
+void transform_set(float *transform_data)
+{
+  memcpy(transform.data, transform_data, sizeof(transform.data));
+  settings_write_transform(transform.data);
+  transform_compute();
+}
+
+
+void transform_get(float *transform_data) { memcpy(transform_data, transform.data, sizeof(transform.data)); }
+
+
+// Transforms the XY of the position about the center. Cloned axes follow the first axis of the same name.
+static void transform_xy(float *position, float *matrix)
+{
+  float x = position[AXIS_LETTER_INDEX('X')]-transform.data[TRANSFORM_CENTER_X];
+  float y = position[AXIS_LETTER_INDEX('Y')]-transform.data[TRANSFORM_CENTER_Y];
+  float transformed_x = transform.data[TRANSFORM_CENTER_X] + matrix[0]*x + matrix[1]*y;
+  float transformed_y = transform.data[TRANSFORM_CENTER_Y] + matrix[2]*x + matrix[3]*y;
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) {
+    if (bit_istrue(AXIS_LETTER_MASK('X'),bit(idx))) { position[idx] = transformed_x; }
+    else if (bit_istrue(AXIS_LETTER_MASK('Y'),bit(idx))) { position[idx] = transformed_y; }
+  }
+}
+
+
+void transform_apply(float *position)
+{
+  if (transform.enabled) { transform_xy(position, transform.matrix); }
+}
+
+
+void transform_remove(float *position)
+{
+  if (transform.enabled) { transform_xy(position, transform.inverse); }
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+  transform.h - G68 coordinate transform of the XY plane
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef transform_h
+#define transform_h
+
+// Loads the transform stored in EEPROM. Called upon every reset.
+void transform_init();
+
+// Sets and stores the transform. See TRANSFORM_* in settings.h for the data layout.
+void transform_set(float *transform_data);
+
+// Copies the transform data.
+void transform_get(float *transform_data);
+
+// Converts the XY of a programmed position to machine coordinates.
+void transform_apply(float *position);
+
+// Converts the XY of a machine position to programmed coordinates.
+void transform_remove(float *position);
+
+#endif
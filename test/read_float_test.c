@@ -0,0 +1,217 @@
+/*
+  read_float_test.c - host test of the fixed-point g-code value reader
+  Part of Grbl
+
+  Copyright (c) 2017-2022 Gauthier Briere
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Checks that read_float_fixed() returns the same value, command number and mantissa as the former
+// read_float() followed by the parser trunc() and round() calls, over all the command words, line
+// numbers and values with up to three decimals. Ties on the third decimal are the one difference, as
+// the fixed mantissa rounds them up. Built and run on the host with 'make test'.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+// Minimal host environment of nuts_bolts.c, in place of grbl.h and the AVR headers.
+#define grbl_h
+#define __flash
+#define F_CPU 16000000UL
+#define N_AXIS 3
+#define AXIS_1 0
+#define AXIS_2 1
+#define AXIS_3 2
+#define AXIS_1_NAME 'X'
+#define AXIS_2_NAME 'Y'
+#define AXIS_3_NAME 'Z'
+#define DWELL_TIME_STEP 50
+#define SUSPEND_RESTART_RETRACT bit(3)
+#include "../grbl/nuts_bolts.h"
+
+static struct { uint8_t abort; uint8_t suspend; } sys;
+static void protocol_execute_realtime() { }
+static void protocol_exec_rt_system() { }
+#define _delay_ms(ms)
+#define _delay_us(us)
+
+#include "../grbl/nuts_bolts.c"
+
+
+// The former read_float(), kept as the reference.
+static uint8_t read_float_reference(char *line, uint8_t *char_counter, float *float_ptr)
+{
+  char *ptr = line + *char_counter;
+  unsigned char c;
+
+  // Grab first character and increment pointer. No spaces assumed in line.
+  c = *ptr++;
+
+  // Capture initial positive/minus character
+  bool isnegative = false;
+  if (c == '-') {
+    isnegative = true;
+    c = *ptr++;
+  } else if (c == '+') {
+    c = *ptr++;
+  }
+
+  // Extract number into fast integer. Track decimal in terms of exponent value.
+  uint32_t intval = 0;
+  int8_t exp = 0;
+  uint8_t ndigit = 0;
+  bool isdecimal = false;
+  while(1) {
+    c -= '0';
+    if (c <= 9) {
+      ndigit++;
+      if (ndigit <= MAX_INT_DIGITS) {
+        if (isdecimal) { exp--; }
+        intval = (((intval << 2) + intval) << 1) + c; // intval*10 + c
+      } else {
+        if (!(isdecimal)) { exp++; }  // Drop overflow digits
+      }
+    } else if (c == (('.'-'0') & 0xff)  &&  !(isdecimal)) {
+      isdecimal = true;
+    } else {
+      break;
+    }
+    c = *ptr++;
+  }
+
+  // Return if no digits have been read.
+  if (!ndigit) { return(false); };
+
+  // Convert integer into floating point.
+  float fval;
+  fval = (float)intval;
+
+  // Apply decimal. Should perform no more than two floating point multiplications for the
+  // expected range of E0 to E-4.
+  if (fval != 0) {
+    while (exp <= -2) {
+      fval *= 0.01;
+      exp += 2;
+    }
+    if (exp < 0) {
+      fval *= 0.1;
+    } else if (exp > 0) {
+      do {
+        fval *= 10.0;
+      } while (--exp > 0);
+    }
+  }
+
+  // Assign floating point value with correct sign.
+  if (isnegative) {
+    *float_ptr = -fval;
+  } else {
+    *float_ptr = fval;
+  }
+
+  *char_counter = ptr - line - 1; // Set char_counter to next statement
+
+  return(true);
+}
+
+
+static uint32_t n_checked = 0;
+static uint32_t n_failed = 0;
+static uint32_t n_tie = 0;
+
+// Reads the word value both ways. is_command compares the uint8 command number and mantissa, as the
+// parser computed them with trunc() and round(). Otherwise, the int32 line number is compared.
+static void check(const char *value, uint8_t is_command)
+{
+  char line[32];
+  float ref_value = 0.0, fixed_value = 0.0;
+  int32_t int_part = 0;
+  uint8_t mantissa = 0;
+  uint8_t ref_counter = 0, fixed_counter = 0;
+
+  snprintf(line, sizeof(line), "%sX", value); // Followed by the next word.
+  uint8_t ref_ok = read_float_reference(line, &ref_counter, &ref_value);
+  uint8_t fixed_ok = read_float_fixed(line, &fixed_counter, &fixed_value, &int_part, &mantissa);
+  uint8_t failed = (ref_ok != fixed_ok) || (ref_counter != fixed_counter);
+  if (ref_ok && !failed) {
+    if (memcmp(&ref_value, &fixed_value, sizeof(float))) { failed = true; }
+    if (is_command) {
+      uint8_t ref_int_value = trunc(ref_value);
+      uint8_t ref_mantissa = round(100*(ref_value - ref_int_value));
+      // A third decimal of 5 is a tie. The fixed mantissa rounds it up, while the float one rounds
+      // either way, with the binary representation error of the value.
+      char *point = strchr(value, '.');
+      if ((point != NULL) && (strlen(point) == 4) && (point[3] == '5') && (mantissa == ref_mantissa+1)) {
+        ref_mantissa++;
+        n_tie++;
+      }
+      if (((uint8_t)int_part != ref_int_value) || (mantissa != ref_mantissa)) { failed = true; }
+    } else {
+      if (int_part != (int32_t)trunc(ref_value)) { failed = true; }
+    }
+  }
+  n_checked++;
+  if (failed) {
+    n_failed++;
+    printf("FAIL '%s': reference %d %g, fixed %d %g %ld.%02u\n", value, ref_ok, ref_value, fixed_ok,
+      fixed_value, (long)int_part, mantissa);
+  }
+}
+
+
+int main()
+{
+  char value[32];
+  uint16_t int_value, fraction;
+
+  // Command words, like G38.2 or M100, with up to three decimals. The parser only accepts
+  // non-negative command numbers below 256.
+  for (int_value=0; int_value<256; int_value++) {
+    snprintf(value, sizeof(value), "%u", int_value); check(value, true);
+    snprintf(value, sizeof(value), "%u.", int_value); check(value, true);
+    snprintf(value, sizeof(value), "0%u", int_value); check(value, true);
+    for (fraction=0; fraction<10; fraction++) {
+      snprintf(value, sizeof(value), "%u.%u", int_value, fraction); check(value, true);
+    }
+    for (fraction=0; fraction<100; fraction++) {
+      snprintf(value, sizeof(value), "%u.%02u", int_value, fraction); check(value, true);
+    }
+    for (fraction=0; fraction<1000; fraction++) {
+      snprintf(value, sizeof(value), "%u.%03u", int_value, fraction); check(value, true);
+    }
+  }
+  snprintf(value, sizeof(value), "+38.2"); check(value, true);
+
+  // Line numbers, up to the largest one the parser accepts.
+  uint32_t n;
+  for (n=0; n<=10000000; n += (n < 100000) ? 1 : 997) {
+    snprintf(value, sizeof(value), "%lu", (unsigned long)n); check(value, false);
+  }
+  check("10000000", false);
+
+  // Malformed values.
+  check("", true);
+  check("-", true);
+  check(".", true);
+  check("+.", true);
+
+  printf("%lu values checked, %lu ties rounded up, %lu failed\n", (unsigned long)n_checked,
+    (unsigned long)n_tie, (unsigned long)n_failed);
+  return(n_failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}